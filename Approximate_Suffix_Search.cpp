@@ -0,0 +1,459 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Approximate Search over the Suffix Array (k mismatches / k edits)
+ *
+ *    Description:
+ *    The suffixes that start with a string form one SA interval, and the
+ *    interval for "string + c" is a sub-interval found by binary search on
+ *    the next character. That is all the approximate search needs:
+ *      - h (Hamming, backtracking): walk the pattern down the SA while
+ *        branching on every character present at the current depth, paying
+ *        one error per substitution; branches with k + 1 errors are cut, and
+ *        once k errors are spent the rest of the pattern is matched exactly.
+ *      - H / e (Hamming / edit distance, pigeonhole seeding): cut the pattern
+ *        into at least k + 1 pieces; any occurrence with at most k errors
+ *        contains one piece unchanged. Every exact SA hit of a piece is a
+ *        candidate, verified by counting mismatches (H) or by a Sellers DP
+ *        over the window the occurrence must lie in (e).
+ *    Every query reports its work (SA intervals visited, seed hits,
+ *    verification windows, DP cells), so the strategy and the number of
+ *    pieces can be tuned per workload.
+ *
+ *    Output: h / H report starting positions with their mismatch count; e
+ *    reports end positions (exclusive) with the smallest edit distance of
+ *    any substring ending there, as agrep does.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Approximate_Suffix_Search.cpp -o approx
+ *
+ *    Execution:
+ *         ./approx text.txt < queries.txt
+ *    One query per line: <h|H|e> <k> <pattern> [pieces]
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// --------------------------------------------------------------------
+// Approximate searcher
+// --------------------------------------------------------------------
+class ApproximateSearcher {
+public:
+    struct Match {
+        int position;   // start (h, H) or end (e) of the occurrence
+        int errors;
+    };
+
+    struct Stats {
+        long long nodes = 0;        // SA intervals visited while backtracking
+        long long seeds = 0;        // exact piece lookups
+        long long candidates = 0;   // SA hits of the pieces
+        long long windows = 0;      // verification windows after merging
+        long long cells = 0;        // DP cells (e) or compared bytes (H)
+    };
+
+    struct Query {
+        char mode;      // 'h', 'H' or 'e'
+        int k;
+        string pattern;
+        int pieces;     // 0: k + 1
+    };
+
+    struct Result {
+        vector<Match> matches;
+        Stats stats;
+    };
+
+    ApproximateSearcher(string_view text) : s(text), n(text.size()), suffixArray(buildSuffixArray(text)) {}
+
+    // Occurrences with at most k mismatches, by backtracking over SA intervals
+    vector<Match> mismatches(string_view p, int k, Stats &stats) const {
+        vector<Match> matches;
+        if (p.empty()) return matches;
+        backtrack(p, k, 0, 0, n, 0, matches, stats);
+        sort(matches.begin(), matches.end(), [](const Match &a, const Match &b) { return a.position < b.position; });
+        return matches;
+    }
+
+    // Occurrences with at most k mismatches, by pigeonhole seeding + verification
+    vector<Match> mismatchesSeeded(string_view p, int k, int pieces, Stats &stats) const {
+        int m = p.size();
+        vector<Match> matches;
+        if (m == 0 || m > n) return matches;
+        vector<int> starts;
+        forEachSeedHit(p, k, pieces, stats, [&](int offset, int hit) {
+            int start = hit - offset;
+            if (start >= 0 && start + m <= n) starts.push_back(start);
+        }, [&] {
+            for (int start = 0; start + m <= n; ++start) starts.push_back(start);
+        });
+        sort(starts.begin(), starts.end());
+        starts.erase(unique(starts.begin(), starts.end()), starts.end());
+        stats.windows += starts.size();
+        for (int start : starts) {
+            int errors = 0;
+            for (int j = 0; j < m && errors <= k; ++j) {
+                errors += s[start + j] != p[j];
+                stats.cells++;
+            }
+            if (errors <= k) matches.push_back({start, errors});
+        }
+        return matches;
+    }
+
+    // End positions of substrings within edit distance k, by pigeonhole seeding + Sellers DP
+    /*
+       A piece at pattern offset o found at text position t anchors the
+       alignment: the part of the pattern before the piece ends at t with at
+       most k edits and the part after it starts at t + |piece|, so the whole
+       occurrence lies in [t - o - k, t - o + m + k). Overlapping windows
+       are merged and each merged window gets one DP pass; every alignment
+       with at most k edits lies inside the window of the piece it keeps,
+       so no end is missed and each reported distance is exact.
+    */
+    vector<Match> edits(string_view p, int k, int pieces, Stats &stats) const {
+        int m = p.size();
+        vector<Match> matches;
+        if (m == 0) return matches;
+        vector<pair<int, int>> windows;
+        forEachSeedHit(p, k, pieces, stats, [&](int offset, int hit) {
+            windows.push_back({max(0, hit - offset - k), min(n, hit - offset + m + k)});
+        }, [&] {
+            windows.push_back({0, n});
+        });
+        sort(windows.begin(), windows.end());
+        vector<int> column(m + 1);
+        for (size_t w = 0; w < windows.size();) {
+            auto [lo, hi] = windows[w];
+            for (++w; w < windows.size() && windows[w].first <= hi; ++w) hi = max(hi, windows[w].second);
+            stats.windows++;
+            // Sellers: column[i] = edits between p[0..i) and the best substring ending here
+            iota(column.begin(), column.end(), 0);
+            for (int j = lo; j < hi; ++j) {
+                int diagonal = column[0];
+                for (int i = 1; i <= m; ++i) {
+                    int up = column[i];
+                    column[i] = min({up + 1, column[i - 1] + 1, diagonal + (p[i - 1] != s[j])});
+                    diagonal = up;
+                }
+                stats.cells += m;
+                if (column[m] <= k) matches.push_back({j + 1, column[m]});
+            }
+        }
+        return matches;
+    }
+
+    vector<Result> searchBatch(const vector<Query> &queries) const {
+        vector<Result> results(queries.size());
+        for (size_t q = 0; q < queries.size(); ++q) {
+            const Query &query = queries[q];
+            Result &r = results[q];
+            if (query.mode == 'h') r.matches = mismatches(query.pattern, query.k, r.stats);
+            else if (query.mode == 'H') r.matches = mismatchesSeeded(query.pattern, query.k, query.pieces, r.stats);
+            else r.matches = edits(query.pattern, query.k, query.pieces, r.stats);
+        }
+        return results;
+    }
+
+private:
+    // Byte at depth d of the suffix of rank r, -1 past its end
+    int key(int r, int d) const {
+        int i = suffixArray[r] + d;
+        return i < n ? (unsigned char)s[i] : -1;
+    }
+
+    // Sub-interval of [lo, hi) whose suffixes have byte c at depth d (they all share the first d bytes)
+    pair<int, int> refine(int lo, int hi, int d, int c) const {
+        int a = partition_point(suffixArray.begin() + lo, suffixArray.begin() + hi,
+                                [&](int i) { return i + d >= n || (unsigned char)s[i + d] < c; }) - suffixArray.begin();
+        int b = partition_point(suffixArray.begin() + a, suffixArray.begin() + hi,
+                                [&](int i) { return i + d >= n || (unsigned char)s[i + d] <= c; }) - suffixArray.begin();
+        return {a, b};
+    }
+
+    // Exact SA interval of p
+    pair<int, int> exact(string_view p, int lo, int hi, int depth) const {
+        for (int d = depth; d < (int)p.size() && lo < hi; ++d) {
+            tie(lo, hi) = refine(lo, hi, d, (unsigned char)p[d]);
+        }
+        return {lo, hi};
+    }
+
+    void backtrack(string_view p, int k, int depth, int lo, int hi, int errors,
+                   vector<Match> &matches, Stats &stats) const {
+        stats.nodes++;
+        int m = p.size();
+        if (errors == k) {
+            // No errors left: the rest of the pattern must match exactly
+            tie(lo, hi) = exact(p, lo, hi, depth);
+            depth = m;
+        }
+        if (depth == m) {
+            for (int r = lo; r < hi; ++r) matches.push_back({suffixArray[r], errors});
+            return;
+        }
+        // Suffixes that end at this depth sort first; skip them, then visit one child per byte
+        int r = partition_point(suffixArray.begin() + lo, suffixArray.begin() + hi,
+                                [&](int i) { return i + depth >= n; }) - suffixArray.begin();
+        while (r < hi) {
+            int c = key(r, depth);
+            int next = refine(r, hi, depth, c).second;
+            backtrack(p, k, depth + 1, r, next, errors + (c != (unsigned char)p[depth]), matches, stats);
+            r = next;
+        }
+    }
+
+    // Calls hit(offset, position) for every exact SA hit of every piece; whole() when the pattern is too short to cut
+    template <class Hit, class Whole>
+    void forEachSeedHit(string_view p, int k, int pieces, Stats &stats, Hit hit, Whole whole) const {
+        int m = p.size();
+        pieces = max(pieces, k + 1);
+        if (pieces > m) {
+            whole();
+            return;
+        }
+        for (int j = 0; j < pieces; ++j) {
+            int offset = (long long)m * j / pieces, length = (long long)m * (j + 1) / pieces - offset;
+            auto [lo, hi] = exact(p.substr(offset, length), 0, n, 0);
+            stats.seeds++;
+            stats.candidates += hi - lo;
+            for (int r = lo; r < hi; ++r) hit(offset, suffixArray[r]);
+        }
+    }
+
+    string_view s;
+    int n;
+    vector<int> suffixArray;
+};
+
+/*
+   For every query: "<pattern> <k>: <matches> | <work> | position:errors ..."
+   and the totals of the batch on stderr.
+*/
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    if (argc != 2) {
+        cerr << "usage: " << argv[0] << " <text-file|-> < queries.txt" << endl;
+        return 1;
+    }
+    InputText input;
+    if (!input.open(argv[1])) {
+        cerr << "cannot read " << argv[1] << endl;
+        return 1;
+    }
+    string_view s = input.view();
+    if (s.size() >= (size_t)INT_MAX) {
+        cerr << "text too long for 32-bit indices" << endl;
+        return 1;
+    }
+
+    clock_t z = clock();
+    ApproximateSearcher searcher(s);
+    double buildTime = (double)(clock() - z) / CLOCKS_PER_SEC;
+
+    vector<ApproximateSearcher::Query> queries;
+    string line;
+    while (getline(cin, line)) {
+        istringstream in(line);
+        ApproximateSearcher::Query q = {};
+        if (!(in >> q.mode >> q.k >> q.pattern)) continue;
+        in >> q.pieces;
+        if ((q.mode != 'h' && q.mode != 'H' && q.mode != 'e') || q.k < 0) {
+            cerr << "bad query: " << line << endl;
+            continue;
+        }
+        queries.push_back(q);
+    }
+
+    z = clock();
+    vector<ApproximateSearcher::Result> results = searcher.searchBatch(queries);
+    double searchTime = (double)(clock() - z) / CLOCKS_PER_SEC;
+
+    ApproximateSearcher::Stats total;
+    long long totalMatches = 0;
+    for (size_t q = 0; q < queries.size(); ++q) {
+        const auto &r = results[q];
+        const auto &st = r.stats;
+        cout << queries[q].mode << ' ' << queries[q].pattern << ' ' << queries[q].k << ": " << r.matches.size();
+        if (queries[q].mode == 'h') cout << " | nodes " << st.nodes;
+        else cout << " | seeds " << st.seeds << " candidates " << st.candidates << " windows " << st.windows
+                  << " cells " << st.cells;
+        cout << " |";
+        for (const auto &match : r.matches) cout << ' ' << match.position << ':' << match.errors;
+        cout << '\n';
+        totalMatches += r.matches.size();
+        total.nodes += st.nodes;
+        total.candidates += st.candidates;
+        total.cells += st.cells;
+    }
+    cout << flush;
+
+    cerr << "Length : " << s.size() << ", Queries : " << queries.size() << ", Matches : " << totalMatches
+         << ", Nodes : " << total.nodes << ", Candidates : " << total.candidates << ", Cells : " << total.cells
+         << ", Build Time : " << buildTime << ", Search Time : " << searchTime << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,902 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Burrows-Wheeler Block Compressor (BWT + MTF + RLE + Huffman)
+ *
+ *    Description:
+ *    The suffix array of a block is its Burrows-Wheeler transform: the
+ *    character before every suffix, in suffix order. Equal contexts end up
+ *    next to each other, so the transform is full of runs that the later
+ *    stages squeeze out, as in bzip2:
+ *      1. BWT of every block through buildSuffixArray (SA-IS, O(n)),
+ *      2. move-to-front, which turns the runs into runs of zeros,
+ *      3. zero-run encoding (RUNA/RUNB, bijective base 2),
+ *      4. canonical Huffman coding with up to 6 code tables per block, one
+ *         chosen per group of 50 symbols (lengths <= 20 bits).
+ *    Decompression undoes every stage; the BWT is inverted in O(n) with the
+ *    LF mapping. Blocks are independent, so a batch of them is compressed
+ *    (or decompressed) in parallel on a thread pool, then written in order.
+ *
+ *    File format (integers little-endian):
+ *         "BWTZ" u8 version
+ *         frames: [u32 raw length][u32 payload length][u32 CRC-32 of raw][payload]
+ *         end:    a frame with raw length 0 and payload length 0
+ *    Payload: [u32 primary index][u32 groups][bits: byte map, selectors, code lengths, symbols]
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall -pthread BWT_Compressor.cpp -o bwtc
+ *
+ *    Execution:
+ *         ./bwtc c [block-size] [threads] < app.log > app.log.bwtz
+ *         ./bwtc d [threads] < app.log.bwtz > app.log
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(const unsigned char *s, int n) {
+    vector<int> symbols(s, s + n);
+    return inducedSort(symbols, 255);
+}
+
+// --------------------------------------------------------------------
+// Thread pool: the caller acts as worker 0, the pool owns workers 1..T-1
+// --------------------------------------------------------------------
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads) : numThreads(max(1, numThreads)) {
+        for (int t = 1; t < this->numThreads; t++) {
+            workers.emplace_back([this, t] { workerLoop(t); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+            generation++;
+        }
+        wake.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    int size() const { return numThreads; }
+
+    // Runs task(t) for every t in [0, size()) and waits for all of them
+    void run(const function<void(int)> &task) {
+        {
+            lock_guard<mutex> lock(mtx);
+            current = &task;
+            pending = numThreads - 1;
+            generation++;
+        }
+        wake.notify_all();
+        task(0);
+        unique_lock<mutex> lock(mtx);
+        finished.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+private:
+    void workerLoop(int t) {
+        long long seen = 0;
+        while (true) {
+            const function<void(int)> *task;
+            {
+                unique_lock<mutex> lock(mtx);
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) return;
+                task = current;
+            }
+            (*task)(t);
+            {
+                lock_guard<mutex> lock(mtx);
+                if (--pending == 0) finished.notify_one();
+            }
+        }
+    }
+
+    int numThreads;
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable wake, finished;
+    const function<void(int)> *current = nullptr;
+    long long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+// --------------------------------------------------------------------
+// Burrows-Wheeler transform
+// --------------------------------------------------------------------
+/*
+   The rows are the rotations of s$ in sorted order. Row 0 is "$s" (the
+   sentinel is smallest), row r + 1 is the suffix SA[r], and the last
+   column holds the character before each of them: s[n - 1] for row 0,
+   s[SA[r] - 1] otherwise, and '$' for the row of suffix 0. That row is the
+   primary index; the '$' itself is not stored, so the output has n bytes.
+*/
+int bwtForward(const unsigned char *s, int n, unsigned char *out) {
+    vector<int> suffixArray = buildSuffixArray(s, n);
+    int primary = 0, k = 0;
+    out[k++] = s[n - 1];
+    for (int r = 0; r < n; ++r) {
+        if (suffixArray[r] == 0) primary = r + 1;
+        else out[k++] = s[suffixArray[r] - 1];
+    }
+    return primary;
+}
+
+// Inverse BWT with the LF mapping, O(n); returns false if the input is inconsistent
+/*
+   LF(i) is the row of the rotation that starts with the last character of
+   row i: C[c] (rows starting with a smaller symbol, '$' included) plus the
+   number of c's above row i in the last column. Row 0 ends with s[n - 1],
+   so following LF from row 0 spells s backwards and reaches the primary
+   row exactly after n steps.
+*/
+bool bwtInverse(const unsigned char *last, int n, int primary, unsigned char *out) {
+    if (primary < 1 || primary > n) return false;
+    array<int, 256> C = {};
+    for (int i = 0; i < n; ++i) C[last[i]]++;
+    for (int c = 0, sum = 1; c < 256; ++c) {
+        int count = C[c];
+        C[c] = sum;
+        sum += count;
+    }
+    // Stored index i is row i, or row i + 1 past the primary
+    int row = 0;
+    if (n < (1 << 24)) {
+        // As in bzip2: LF(i) << 8 | last character in one word, one random access per step
+        vector<uint32_t> lf(n + 1);
+        lf[primary] = 0;
+        for (int i = 0; i < n; ++i) {
+            lf[i < primary ? i : i + 1] = (uint32_t)C[last[i]]++ << 8 | last[i];
+        }
+        for (int k = n - 1; k >= 0; --k) {
+            if (row == primary) return false;
+            out[k] = lf[row] & 0xFF;
+            row = lf[row] >> 8;
+        }
+    } else {
+        vector<int> lf(n + 1);
+        lf[primary] = 0;
+        for (int i = 0; i < n; ++i) {
+            lf[i < primary ? i : i + 1] = C[last[i]]++;
+        }
+        for (int k = n - 1; k >= 0; --k) {
+            if (row == primary) return false;
+            out[k] = last[row < primary ? row : row - 1];
+            row = lf[row];
+        }
+    }
+    return row == primary;
+}
+
+// --------------------------------------------------------------------
+// Move-to-front + zero-run encoding
+// --------------------------------------------------------------------
+/*
+   MTF runs over the bytes that occur in the block only (inUse, in byte
+   order), so ranks stay below their count m. Rank r >= 1 becomes symbol
+   r + 1; a run of z zeros is written in bijective base 2 with digits RUNA
+   (1) and RUNB (2), least significant first, so a run of a million zeros
+   costs 20 symbols. EOB = m + 1 ends the block: the alphabet has m + 2
+   symbols.
+*/
+const int RUNA = 0, RUNB = 1;
+
+vector<uint16_t> mtfEncode(const unsigned char *s, int n, const vector<bool> &inUse) {
+    vector<uint16_t> out;
+    out.reserve(n / 2 + 16);
+    unsigned char order[256], index[256];
+    int m = 0;
+    for (int c = 0; c < 256; ++c) {
+        if (inUse[c]) order[m] = m, index[c] = m++;
+    }
+    long long zeros = 0;
+    auto flushZeros = [&] {
+        while (zeros > 0) {
+            if (zeros & 1) {
+                out.push_back(RUNA);
+                zeros = (zeros - 1) / 2;
+            } else {
+                out.push_back(RUNB);
+                zeros = (zeros - 2) / 2;
+            }
+        }
+    };
+    for (int i = 0; i < n; ++i) {
+        unsigned char c = index[s[i]];
+        if (order[0] == c) {
+            zeros++;
+            continue;
+        }
+        flushZeros();
+        int r = 1;
+        unsigned char prev = order[0];
+        while (order[r] != c) {
+            swap(prev, order[r]);
+            r++;
+        }
+        order[r] = prev;
+        order[0] = c;
+        out.push_back(r + 1);
+    }
+    flushZeros();
+    out.push_back(m + 1);
+    return out;
+}
+
+// --------------------------------------------------------------------
+// Canonical Huffman code
+// --------------------------------------------------------------------
+const int MAX_CODE_LENGTH = 20, FAST_BITS = 11;
+
+// Code lengths for the given frequencies, none longer than MAX_CODE_LENGTH
+/*
+   Plain Huffman first; if the tree is too deep, the frequencies are
+   flattened (f -> f / 2 + 1, as bzip2 does) and the tree rebuilt, which
+   converges in a few rounds and costs next to nothing in ratio.
+*/
+vector<int> huffmanLengths(vector<long long> freq) {
+    int m = freq.size();
+    vector<int> length(m, 0);
+    while (true) {
+        vector<long long> weight;
+        vector<int> parent;
+        priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<>> pq;
+        for (int c = 0; c < m; ++c) {
+            if (freq[c] > 0) {
+                pq.push({freq[c], (int)weight.size()});
+                weight.push_back(freq[c]);
+                parent.push_back(-1);
+            }
+        }
+        if (weight.size() == 1) {
+            for (int c = 0; c < m; ++c) length[c] = freq[c] > 0;
+            return length;
+        }
+        while (pq.size() > 1) {
+            auto [wa, a] = pq.top(); pq.pop();
+            auto [wb, b] = pq.top(); pq.pop();
+            int node = weight.size();
+            weight.push_back(wa + wb);
+            parent.push_back(-1);
+            parent[a] = parent[b] = node;
+            pq.push({wa + wb, node});
+        }
+        // Parents are created after their children, so depths resolve top-down
+        vector<int> depth(weight.size(), 0);
+        for (int v = weight.size() - 2; v >= 0; --v) depth[v] = depth[parent[v]] + 1;
+        int maxLength = 0;
+        for (int c = 0, leaf = 0; c < m; ++c) {
+            length[c] = freq[c] > 0 ? depth[leaf++] : 0;
+            maxLength = max(maxLength, length[c]);
+        }
+        if (maxLength <= MAX_CODE_LENGTH) return length;
+        for (auto &f : freq) {
+            if (f > 0) f = f / 2 + 1;
+        }
+    }
+}
+
+// Canonical codes: shorter codes first, equal lengths in symbol order
+vector<uint32_t> canonicalCodes(const vector<int> &length) {
+    vector<uint32_t> code(length.size(), 0);
+    uint32_t next = 0;
+    for (int len = 1; len <= MAX_CODE_LENGTH; ++len) {
+        for (size_t c = 0; c < length.size(); ++c) {
+            if (length[c] == len) code[c] = next++;
+        }
+        next <<= 1;
+    }
+    return code;
+}
+
+// MSB-first bit writer
+struct BitWriter {
+    string &out;
+    uint64_t buffer = 0;
+    int bits = 0;
+
+    explicit BitWriter(string &out) : out(out) {}
+
+    void put(uint32_t value, int count) {
+        buffer = (buffer << count) | value;
+        bits += count;
+        while (bits >= 8) {
+            bits -= 8;
+            out.push_back((char)(buffer >> bits));
+        }
+    }
+
+    void flush() {
+        if (bits > 0) out.push_back((char)(buffer << (8 - bits)));
+        bits = 0;
+    }
+};
+
+// MSB-first bit reader; reading past the end yields zero bits and sets overrun
+struct BitReader {
+    const unsigned char *data;
+    size_t size, pos = 0;
+    uint64_t buffer = 0;
+    int bits = 0;
+    long long consumed = 0;
+
+    BitReader(const unsigned char *data, size_t size) : data(data), size(size) {}
+
+    uint32_t peek(int count) {
+        while (bits < count) {
+            buffer = (buffer << 8) | (pos < size ? data[pos] : 0);
+            pos++;
+            bits += 8;
+        }
+        return (buffer >> (bits - count)) & ((1u << count) - 1);
+    }
+
+    void skip(int count) {
+        bits -= count;
+        consumed += count;
+    }
+
+    uint32_t get(int count) {
+        uint32_t value = peek(count);
+        skip(count);
+        return value;
+    }
+
+    bool overrun() const { return consumed > (long long)size * 8; }
+};
+
+// Table-driven decoder: codes up to FAST_BITS long resolve in one lookup
+/*
+   fast[] is indexed by the next FAST_BITS bits and holds (symbol, length)
+   for every short code. Longer codes fall back to the canonical walk:
+   codes of one length are consecutive, so a prefix of length len is a
+   code exactly when it is below first[len] + count[len].
+*/
+struct HuffmanDecoder {
+    vector<uint32_t> fast;
+    int first[MAX_CODE_LENGTH + 2] = {}, count[MAX_CODE_LENGTH + 2] = {}, offset[MAX_CODE_LENGTH + 2] = {};
+    vector<int> sorted;
+
+    // Returns false if the lengths do not form a prefix code
+    bool init(const vector<int> &length) {
+        for (int len : length) count[len]++;
+        count[0] = 0;
+        long long room = 1;
+        for (int len = 1; len <= MAX_CODE_LENGTH; ++len) {
+            room = room * 2 - count[len];
+            if (room < 0) return false;
+        }
+        int code = 0, index = 0;
+        for (int len = 1; len <= MAX_CODE_LENGTH; ++len) {
+            first[len] = code;
+            offset[len] = index;
+            index += count[len];
+            code = (code + count[len]) << 1;
+        }
+        sorted.assign(index, 0);
+        vector<int> fill(offset, offset + MAX_CODE_LENGTH + 1);
+        for (size_t c = 0; c < length.size(); ++c) {
+            if (length[c] > 0) sorted[fill[length[c]]++] = c;
+        }
+
+        fast.assign(1 << FAST_BITS, 0);
+        vector<uint32_t> code32 = canonicalCodes(length);
+        for (size_t c = 0; c < length.size(); ++c) {
+            int len = length[c];
+            if (len == 0 || len > FAST_BITS) continue;
+            uint32_t lo = code32[c] << (FAST_BITS - len), hi = lo + (1u << (FAST_BITS - len));
+            for (uint32_t x = lo; x < hi; ++x) fast[x] = (c << 8) | len;
+        }
+        return true;
+    }
+
+    // Next symbol, or -1 on an invalid code
+    int decode(BitReader &in) const {
+        uint32_t entry = fast[in.peek(FAST_BITS)];
+        if (entry != 0) {
+            in.skip(entry & 0xFF);
+            return entry >> 8;
+        }
+        uint32_t code = in.peek(MAX_CODE_LENGTH);
+        for (int len = FAST_BITS + 1; len <= MAX_CODE_LENGTH; ++len) {
+            int prefix = code >> (MAX_CODE_LENGTH - len);
+            if (prefix - first[len] < count[len]) {
+                in.skip(len);
+                return sorted[offset[len] + prefix - first[len]];
+            }
+        }
+        return -1;
+    }
+};
+
+// --------------------------------------------------------------------
+// Multiple code tables (bzip2)
+// --------------------------------------------------------------------
+/*
+   The statistics of MTF output drift along a block, so the symbols are cut
+   into groups of GROUP_SIZE and every group picks the cheapest of up to
+   MAX_TABLES codes. The tables start as a split of the alphabet into
+   ranges of equal total frequency, then ITERATIONS rounds of "every group
+   picks its cheapest table, every table is rebuilt from the groups that
+   picked it" refine them (a k-means over groups). The choices (selectors)
+   are MTF-coded and written in unary, most of them as a single 0 bit.
+*/
+const int GROUP_SIZE = 50, MAX_TABLES = 6, ITERATIONS = 4;
+
+struct TableChoice {
+    vector<vector<int>> lengths;
+    vector<unsigned char> selectors;
+};
+
+TableChoice chooseTables(const vector<uint16_t> &symbols, int alphabet) {
+    int total = symbols.size();
+    int numTables = total < 200 ? 2 : total < 600 ? 3 : total < 1200 ? 4 : total < 2400 ? 5 : MAX_TABLES;
+    int numGroups = (total + GROUP_SIZE - 1) / GROUP_SIZE;
+    vector<long long> freq(alphabet, 0);
+    for (uint16_t x : symbols) freq[x]++;
+
+    TableChoice choice;
+    choice.lengths.assign(numTables, vector<int>(alphabet, 15));
+    long long remaining = total;
+    for (int part = numTables, lo = 0; part > 0; --part) {
+        long long target = remaining / part, sum = 0;
+        int hi = lo - 1;
+        while (sum < target && hi < alphabet - 1) sum += freq[++hi];
+        if (hi > lo && part != numTables && part != 1 && (numTables - part) % 2 == 1) sum -= freq[hi--];
+        for (int v = lo; v <= hi; ++v) choice.lengths[part - 1][v] = 0;
+        lo = hi + 1;
+        remaining -= sum;
+    }
+
+    choice.selectors.assign(numGroups, 0);
+    for (int iter = 0; iter < ITERATIONS; ++iter) {
+        vector<vector<long long>> tableFreq(numTables, vector<long long>(alphabet, 0));
+        for (int g = 0; g < numGroups; ++g) {
+            int lo = g * GROUP_SIZE, hi = min(total, lo + GROUP_SIZE);
+            int best = 0;
+            long long bestCost = LLONG_MAX;
+            for (int t = 0; t < numTables; ++t) {
+                long long cost = 0;
+                for (int i = lo; i < hi; ++i) cost += choice.lengths[t][symbols[i]];
+                if (cost < bestCost) bestCost = cost, best = t;
+            }
+            choice.selectors[g] = best;
+            for (int i = lo; i < hi; ++i) tableFreq[best][symbols[i]]++;
+        }
+        // Every symbol keeps a code in every table: any group may pick any table
+        for (int t = 0; t < numTables; ++t) {
+            for (auto &f : tableFreq[t]) f = max(f, 1LL);
+            choice.lengths[t] = huffmanLengths(tableFreq[t]);
+        }
+    }
+    return choice;
+}
+
+// --------------------------------------------------------------------
+// Blocks
+// --------------------------------------------------------------------
+uint32_t crc32(const unsigned char *data, size_t n) {
+    static const auto table = [] {
+        array<uint32_t, 256> t;
+        for (uint32_t c = 0; c < 256; ++c) {
+            uint32_t x = c;
+            for (int k = 0; k < 8; ++k) x = x & 1 ? 0xEDB88320u ^ (x >> 1) : x >> 1;
+            t[c] = x;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void putU32(string &out, uint32_t x) {
+    for (int k = 0; k < 4; ++k) out.push_back((char)(x >> (8 * k)));
+}
+
+uint32_t getU32(const unsigned char *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+struct Block {
+    string raw, payload;
+    uint32_t crc = 0;
+    bool ok = true;
+};
+
+/*
+   Payload: [u32 primary][u32 groups][bits: 256-bit byte map, 3-bit table
+   count, unary MTF selectors, 5-bit code lengths per table, symbols]
+*/
+void compressBlock(Block &block) {
+    int n = block.raw.size();
+    const unsigned char *s = (const unsigned char *)block.raw.data();
+    block.crc = crc32(s, n);
+
+    string last(n, '\0');
+    int primary = bwtForward(s, n, (unsigned char *)last.data());
+    vector<bool> inUse(256, false);
+    for (int i = 0; i < n; ++i) inUse[s[i]] = true;
+    int alphabet = count(inUse.begin(), inUse.end(), true) + 2;
+    vector<uint16_t> symbols = mtfEncode((const unsigned char *)last.data(), n, inUse);
+    TableChoice choice = chooseTables(symbols, alphabet);
+    int numTables = choice.lengths.size(), numGroups = choice.selectors.size();
+
+    string &out = block.payload;
+    out.clear();
+    putU32(out, primary);
+    putU32(out, numGroups);
+    BitWriter bits(out);
+    for (int c = 0; c < 256; ++c) bits.put(inUse[c], 1);
+    bits.put(numTables, 3);
+    vector<unsigned char> order(numTables);
+    iota(order.begin(), order.end(), 0);
+    for (unsigned char sel : choice.selectors) {
+        int r = find(order.begin(), order.end(), sel) - order.begin();
+        rotate(order.begin(), order.begin() + r, order.begin() + r + 1);
+        bits.put((1u << (r + 1)) - 2, r + 1);     // r ones, then a zero
+    }
+    vector<vector<uint32_t>> codes;
+    for (auto &length : choice.lengths) {
+        for (int len : length) bits.put(len, 5);
+        codes.push_back(canonicalCodes(length));
+    }
+    for (int i = 0; i < (int)symbols.size(); ++i) {
+        int t = choice.selectors[i / GROUP_SIZE];
+        bits.put(codes[t][symbols[i]], choice.lengths[t][symbols[i]]);
+    }
+    bits.flush();
+}
+
+void decompressBlock(Block &block, uint32_t rawLength) {
+    block.ok = false;
+    const unsigned char *p = (const unsigned char *)block.payload.data();
+    size_t size = block.payload.size();
+    if (size < 8 || rawLength == 0) return;
+    int n = rawLength;
+    int primary = getU32(p);
+    long long numGroups = getU32(p + 4);
+    // Every group but the last holds GROUP_SIZE symbols, each at least one bit
+    if (numGroups == 0 || (numGroups - 1) * GROUP_SIZE > (long long)size * 8) return;
+
+    BitReader in(p + 8, size - 8);
+    unsigned char byteOf[256];
+    int m = 0;
+    for (int c = 0; c < 256; ++c) {
+        if (in.get(1)) byteOf[m++] = c;
+    }
+    int alphabet = m + 2, numTables = in.get(3);
+    if (m == 0 || numTables < 2 || numTables > MAX_TABLES) return;
+    vector<unsigned char> selectors(numGroups), order(numTables);
+    iota(order.begin(), order.end(), 0);
+    for (auto &sel : selectors) {
+        int r = 0;
+        while (in.get(1)) {
+            if (++r >= numTables) return;
+        }
+        sel = order[r];
+        rotate(order.begin(), order.begin() + r, order.begin() + r + 1);
+    }
+    vector<HuffmanDecoder> decoders(numTables);
+    for (auto &decoder : decoders) {
+        vector<int> length(alphabet);
+        for (int &len : length) {
+            len = in.get(5);
+            if (len > MAX_CODE_LENGTH) return;
+        }
+        if (!decoder.init(length)) return;
+    }
+    if (in.overrun()) return;
+
+    // Zero runs and MTF in one pass
+    string last(n, '\0');
+    unsigned char mtf[256];
+    iota(mtf, mtf + 256, 0);
+    long long k = 0, run = 0, weight = 1;
+    for (long long i = 0;; ++i) {
+        if (i / GROUP_SIZE >= numGroups) return;
+        int x = decoders[selectors[i / GROUP_SIZE]].decode(in);
+        if (x < 0 || in.overrun()) return;
+        if (x == RUNA || x == RUNB) {
+            run += weight << (x == RUNB);
+            weight <<= 1;
+            if (run > n - k) return;
+            continue;
+        }
+        if (run > 0) {
+            memset(&last[k], byteOf[mtf[0]], run);
+            k += run;
+            run = 0;
+        }
+        weight = 1;
+        if (x == alphabet - 1) break;
+        int r = x - 1;
+        if (k >= n) return;
+        unsigned char c = mtf[r];
+        memmove(mtf + 1, mtf, r);
+        mtf[0] = c;
+        last[k++] = byteOf[c];
+    }
+    if (k != n) return;
+
+    block.raw.assign(n, '\0');
+    if (!bwtInverse((const unsigned char *)last.data(), n, primary, (unsigned char *)block.raw.data())) return;
+    block.ok = crc32((const unsigned char *)block.raw.data(), n) == block.crc;
+}
+
+// --------------------------------------------------------------------
+// Streams
+// --------------------------------------------------------------------
+const char MAGIC[4] = {'B', 'W', 'T', 'Z'};
+const unsigned char VERSION = 1;
+const size_t MAX_BLOCK = 1u << 30;
+
+bool readExactly(FILE *in, void *buffer, size_t n) { return fread(buffer, 1, n, in) == n; }
+
+struct Totals {
+    size_t in = 0, out = 0;
+};
+
+/*
+   Batches of `threads` blocks: read them in order, transform all of them on
+   the pool, write them in order. The batch is the only buffering, so memory
+   stays at about threads x (block size x 10) whatever the input size.
+*/
+Totals compressStream(FILE *in, FILE *out, size_t blockSize, ThreadPool &pool) {
+    Totals totals;
+    fwrite(MAGIC, 1, 4, out);
+    fwrite(&VERSION, 1, 1, out);
+    totals.out = 5;
+    vector<Block> batch(pool.size());
+    while (true) {
+        int filled = 0;
+        for (auto &block : batch) {
+            block.raw.resize(blockSize);
+            block.raw.resize(fread(&block.raw[0], 1, blockSize, in));
+            if (block.raw.empty()) break;
+            filled++;
+        }
+        pool.run([&](int t) {
+            if (t < filled) compressBlock(batch[t]);
+        });
+        for (int t = 0; t < filled; ++t) {
+            string header;
+            putU32(header, batch[t].raw.size());
+            putU32(header, batch[t].payload.size());
+            putU32(header, batch[t].crc);
+            fwrite(header.data(), 1, header.size(), out);
+            fwrite(batch[t].payload.data(), 1, batch[t].payload.size(), out);
+            totals.in += batch[t].raw.size();
+            totals.out += header.size() + batch[t].payload.size();
+        }
+        if (filled < (int)batch.size()) break;
+    }
+    string end;
+    putU32(end, 0);
+    putU32(end, 0);
+    putU32(end, 0);
+    fwrite(end.data(), 1, end.size(), out);
+    totals.out += end.size();
+    return totals;
+}
+
+// Returns false (with a message) on a malformed or corrupted stream
+bool decompressStream(FILE *in, FILE *out, ThreadPool &pool, Totals &totals, string &error) {
+    char magic[5];
+    if (!readExactly(in, magic, 5) || memcmp(magic, MAGIC, 4) != 0) {
+        error = "not a BWTZ stream";
+        return false;
+    }
+    if ((unsigned char)magic[4] != VERSION) {
+        error = "unsupported BWTZ version " + to_string((unsigned char)magic[4]);
+        return false;
+    }
+    totals.in = 5;
+    vector<Block> batch(pool.size());
+    vector<uint32_t> rawLength(pool.size());
+    long long frame = 0;
+    bool done = false;
+    while (!done) {
+        int filled = 0;
+        for (int t = 0; t < (int)batch.size(); ++t) {
+            unsigned char header[12];
+            if (!readExactly(in, header, 12)) {
+                error = "truncated stream";
+                return false;
+            }
+            rawLength[t] = getU32(header);
+            uint32_t payloadLength = getU32(header + 4);
+            batch[t].crc = getU32(header + 8);
+            totals.in += 12;
+            if (rawLength[t] == 0) {
+                done = true;
+                break;
+            }
+            if (rawLength[t] > MAX_BLOCK || payloadLength > 2 * MAX_BLOCK) {
+                error = "invalid frame header";
+                return false;
+            }
+            batch[t].payload.resize(payloadLength);
+            if (!readExactly(in, &batch[t].payload[0], payloadLength)) {
+                error = "truncated stream";
+                return false;
+            }
+            totals.in += payloadLength;
+            filled++;
+        }
+        pool.run([&](int t) {
+            if (t < filled) decompressBlock(batch[t], rawLength[t]);
+        });
+        for (int t = 0; t < filled; ++t, ++frame) {
+            if (!batch[t].ok) {
+                error = "corrupted block " + to_string(frame);
+                return false;
+            }
+            fwrite(batch[t].raw.data(), 1, batch[t].raw.size(), out);
+            totals.out += batch[t].raw.size();
+        }
+    }
+    return true;
+}
+
+size_t parseSize(const string &x) {
+    size_t value = stoull(x);
+    char unit = toupper(x.back());
+    if (unit == 'K') value <<= 10;
+    if (unit == 'M') value <<= 20;
+    if (unit == 'G') value <<= 30;
+    return value;
+}
+
+int32_t main(int argc, char *argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode != "c" && mode != "d") {
+        cerr << "usage: " << argv[0] << " c [block-size] [threads] < input > output" << endl;
+        cerr << "       " << argv[0] << " d [threads] < input > output" << endl;
+        return 1;
+    }
+    int threadArg = mode == "c" ? 3 : 2;
+    size_t blockSize = mode == "c" && argc > 2 ? parseSize(argv[2]) : 900 << 10;
+    int threads = argc > threadArg ? atoi(argv[threadArg]) : (int)thread::hardware_concurrency();
+    if (blockSize == 0 || blockSize > MAX_BLOCK) {
+        cerr << "block size must be in [1, 1G]" << endl;
+        return 1;
+    }
+    ThreadPool pool(threads);
+
+    auto start = chrono::steady_clock::now();
+    Totals totals;
+    if (mode == "c") {
+        totals = compressStream(stdin, stdout, blockSize, pool);
+    } else {
+        string error;
+        if (!decompressStream(stdin, stdout, pool, totals, error)) {
+            fflush(stdout);
+            cerr << error << endl;
+            return 1;
+        }
+    }
+    fflush(stdout);
+    double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t raw = mode == "c" ? totals.in : totals.out, packed = mode == "c" ? totals.out : totals.in;
+    cerr << "Raw : " << raw << ", Compressed : " << packed << ", Bits/byte : " << (raw ? 8.0 * packed / raw : 0)
+         << ", Threads : " << pool.size() << ", Wall Time : " << wall << ", MB/s : " << raw / 1048576.0 / max(wall, 1e-9)
+         << endl;
+    return 0;
+}
\ No newline at end of file
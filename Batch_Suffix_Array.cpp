@@ -0,0 +1,403 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Batch Suffix Arrays for Many Short Strings
+ *
+ *    Description:
+ *    For a short string (a URL, a key) the per-call builders in suffix1.cpp
+ *    and suffix2.cpp spend most of their time allocating: suffixArray,
+ *    classes, the temporaries and a cnt of max(257, n) entries, every call.
+ *    buildSuffixArrays() takes the whole batch at once instead:
+ *      - every thread owns one Workspace whose buffers only ever grow, so
+ *        after the first few strings no call allocates at all,
+ *      - strings of at most `threshold` bytes (default 24) are sorted by
+ *        suffix comparisons on 8-byte prefix keys, with no counting arrays
+ *        to clear; longer ones go through the suffix2.cpp prefix doubling
+ *        on the workspace buffers,
+ *      - all suffix arrays land in one flat array, the one for string k in
+ *        [offset[k], offset[k + 1]), so the output is a single allocation,
+ *      - threads take chunks of strings from a shared counter, which keeps
+ *        them balanced when the lengths vary.
+ *    Every suffix array has the n suffixes of its string (no sentinel entry);
+ *    a suffix that is a prefix of another one comes first.
+ *
+ *    Input: one string per line on stdin (split on '\n' only, every other
+ *    byte is part of the string). Output: one suffix array per line; the
+ *    bench mode prints nothing and compares against the per-call builder.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall -pthread Batch_Suffix_Array.cpp -o batch_sa
+ *
+ *    Execution:
+ *         ./batch_sa [threads] [threshold] < strings.txt
+ *         ./batch_sa bench [threads] [threshold] < strings.txt
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// --------------------------------------------------------------------
+// Thread pool: the caller acts as worker 0, the pool owns workers 1..T-1
+// --------------------------------------------------------------------
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads) : numThreads(max(1, numThreads)) {
+        for (int t = 1; t < this->numThreads; t++) {
+            workers.emplace_back([this, t] { workerLoop(t); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+            generation++;
+        }
+        wake.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    int size() const { return numThreads; }
+
+    // Runs task(t) for every t in [0, size()) and waits for all of them
+    void run(const function<void(int)> &task) {
+        {
+            lock_guard<mutex> lock(mtx);
+            current = &task;
+            pending = numThreads - 1;
+            generation++;
+        }
+        wake.notify_all();
+        task(0);
+        unique_lock<mutex> lock(mtx);
+        finished.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+private:
+    void workerLoop(int t) {
+        long long seen = 0;
+        while (true) {
+            const function<void(int)> *task;
+            {
+                unique_lock<mutex> lock(mtx);
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) return;
+                task = current;
+            }
+            (*task)(t);
+            {
+                lock_guard<mutex> lock(mtx);
+                if (--pending == 0) finished.notify_one();
+            }
+        }
+    }
+
+    int numThreads;
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable wake, finished;
+    const function<void(int)> *current = nullptr;
+    long long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// --------------------------------------------------------------------
+// Per-call builder, as in suffix2.cpp: allocates everything on every call
+// --------------------------------------------------------------------
+vector<int> buildSuffixArray(string_view s) {
+    int n = s.size() + 1;
+    vector<int> suffixArray(n), classes(n), c(n), cnt(max(257, n), 0);
+
+    auto key = [&](int i) { return i == n - 1 ? 0 : (unsigned char)s[i] + 1; };
+
+    for (int i = 0; i < n; i++) cnt[key(i)]++;
+    for (int i = 1; i < 257; i++) cnt[i] += cnt[i - 1];
+    for (int i = 0; i < n; i++) suffixArray[--cnt[key(i)]] = i;
+
+    classes[suffixArray[0]] = 0;
+    int numClasses = 1;
+    for (int i = 1; i < n; i++) {
+        if (key(suffixArray[i]) != key(suffixArray[i - 1])) numClasses++;
+        classes[suffixArray[i]] = numClasses - 1;
+    }
+
+    vector<int> tempSuffixArray(n), tempClasses(n);
+    for (int k = 0; (1 << k) < n; k++) {
+        for (int i = 0; i < n; i++) {
+            tempSuffixArray[i] = suffixArray[i] - (1 << k);
+            if (tempSuffixArray[i] < 0) tempSuffixArray[i] += n;
+        }
+
+        fill(cnt.begin(), cnt.begin() + numClasses, 0);
+        for (int i = 0; i < n; i++) cnt[classes[tempSuffixArray[i]]]++;
+        for (int i = 1; i < numClasses; i++) cnt[i] += cnt[i - 1];
+        for (int i = n - 1; i >= 0; i--) suffixArray[--cnt[classes[tempSuffixArray[i]]]] = tempSuffixArray[i];
+
+        tempClasses[suffixArray[0]] = 0;
+        numClasses = 1;
+        for (int i = 1; i < n; i++) {
+            pair<int, int> curr = {classes[suffixArray[i]], classes[(suffixArray[i] + (1 << k)) % n]};
+            pair<int, int> prev = {classes[suffixArray[i - 1]], classes[(suffixArray[i - 1] + (1 << k)) % n]};
+            if (curr != prev) numClasses++;
+            tempClasses[suffixArray[i]] = numClasses - 1;
+        }
+        classes.swap(tempClasses);
+    }
+
+    // Drop the sentinel, which is always ranked first
+    return vector<int>(suffixArray.begin() + 1, suffixArray.end());
+}
+
+// --------------------------------------------------------------------
+// Reusable workspace: buffers grow to the longest string seen, never shrink
+// --------------------------------------------------------------------
+struct Workspace {
+    vector<int> suffixArray, classes, tempSuffixArray, tempClasses, cnt;
+    vector<unsigned long long> prefixKey;
+
+    void reserve(int n) {
+        if ((int)suffixArray.size() >= n) return;
+        n = max(n, 2 * (int)suffixArray.size());
+        suffixArray.resize(n);
+        classes.resize(n);
+        tempSuffixArray.resize(n);
+        tempClasses.resize(n);
+        cnt.resize(max(257, n));
+        prefixKey.resize(n);
+    }
+};
+
+// Small strings: sort the suffixes by comparison on 8-byte prefix keys
+/*
+   prefixKey[i] holds s[i..i+8) big-endian, zero-padded past the end, so
+   comparing two keys compares the first 8 bytes of two suffixes in one
+   instruction; built right to left it costs one shift per position. Only
+   equal keys (a common 8-byte prefix, or a zero byte against the padding)
+   fall back to comparing the suffixes themselves. Below a few dozen bytes
+   these O(n log n) comparisons are cheaper than the counting sorts, whose
+   first round alone clears and scans 257 counters.
+*/
+void sortSuffixesDirect(string_view s, int *out, Workspace &ws) {
+    int n = s.size();
+    ws.reserve(n);
+    unsigned long long *key = ws.prefixKey.data(), next = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        next = next >> 8 | (unsigned long long)(unsigned char)s[i] << 56;
+        key[i] = next;
+    }
+    for (int i = 0; i < n; i++) out[i] = i;
+    sort(out, out + n, [&](int a, int b) {
+        return key[a] != key[b] ? key[a] < key[b] : s.substr(a) < s.substr(b);
+    });
+}
+
+// Longer strings: suffix2.cpp prefix doubling on the workspace buffers
+/*
+   Same cyclic-shift rounds over s plus a sentinel, with the modulo replaced
+   by a compare, the cnt clear limited to the counters in use, and an early
+   stop once every suffix has its own class. The sentinel sorts first and
+   is skipped when the result is copied to out.
+*/
+void sortSuffixesDoubling(string_view s, int *out, Workspace &ws) {
+    int n = s.size() + 1;
+    ws.reserve(n);
+    int *suffixArray = ws.suffixArray.data(), *classes = ws.classes.data();
+    int *tempSuffixArray = ws.tempSuffixArray.data(), *tempClasses = ws.tempClasses.data();
+    int *cnt = ws.cnt.data();
+
+    auto key = [&](int i) { return i == n - 1 ? 0 : (unsigned char)s[i] + 1; };
+
+    fill(cnt, cnt + 257, 0);
+    for (int i = 0; i < n; i++) cnt[key(i)]++;
+    for (int i = 1; i < 257; i++) cnt[i] += cnt[i - 1];
+    for (int i = 0; i < n; i++) suffixArray[--cnt[key(i)]] = i;
+
+    classes[suffixArray[0]] = 0;
+    int numClasses = 1;
+    for (int i = 1; i < n; i++) {
+        if (key(suffixArray[i]) != key(suffixArray[i - 1])) numClasses++;
+        classes[suffixArray[i]] = numClasses - 1;
+    }
+
+    for (int shift = 1; shift < n && numClasses < n; shift <<= 1) {
+        for (int i = 0; i < n; i++) {
+            int p = suffixArray[i] - shift;
+            tempSuffixArray[i] = p < 0 ? p + n : p;
+        }
+
+        fill(cnt, cnt + numClasses, 0);
+        for (int i = 0; i < n; i++) cnt[classes[tempSuffixArray[i]]]++;
+        for (int i = 1; i < numClasses; i++) cnt[i] += cnt[i - 1];
+        for (int i = n - 1; i >= 0; i--) suffixArray[--cnt[classes[tempSuffixArray[i]]]] = tempSuffixArray[i];
+
+        tempClasses[suffixArray[0]] = 0;
+        numClasses = 1;
+        for (int i = 1; i < n; i++) {
+            int a = suffixArray[i], b = suffixArray[i - 1];
+            int a2 = a + shift < n ? a + shift : a + shift - n;
+            int b2 = b + shift < n ? b + shift : b + shift - n;
+            if (classes[a] != classes[b] || classes[a2] != classes[b2]) numClasses++;
+            tempClasses[a] = numClasses - 1;
+        }
+        swap(classes, tempClasses);
+    }
+
+    copy(suffixArray + 1, suffixArray + n, out);
+}
+
+// --------------------------------------------------------------------
+// Batched API
+// --------------------------------------------------------------------
+struct BatchSuffixArrays {
+    vector<long long> offset; // offset[k]..offset[k + 1] is the suffix array of string k
+    vector<int> flat;
+
+    const int *begin(int k) const { return flat.data() + offset[k]; }
+    const int *end(int k) const { return flat.data() + offset[k + 1]; }
+};
+
+const int CHUNK_STRINGS = 256;
+
+// Function to build the suffix arrays of all strings with the pool's threads
+// (workspaces is kept by the caller across batches, so later batches allocate nothing either)
+BatchSuffixArrays buildSuffixArrays(const vector<string_view> &strings, ThreadPool &pool,
+                                    vector<Workspace> &workspaces, int threshold) {
+    int m = strings.size();
+    BatchSuffixArrays result;
+    result.offset.resize(m + 1, 0);
+    for (int k = 0; k < m; k++) result.offset[k + 1] = result.offset[k] + strings[k].size();
+    result.flat.resize(result.offset[m]);
+
+    if ((int)workspaces.size() < pool.size()) workspaces.resize(pool.size());
+
+    atomic<int> nextChunk(0);
+    pool.run([&](int t) {
+        Workspace &ws = workspaces[t];
+        int lo;
+        while ((lo = nextChunk.fetch_add(CHUNK_STRINGS)) < m) {
+            int hi = min(m, lo + CHUNK_STRINGS);
+            for (int k = lo; k < hi; k++) {
+                int *out = result.flat.data() + result.offset[k];
+                if ((int)strings[k].size() <= threshold) sortSuffixesDirect(strings[k], out, ws);
+                else sortSuffixesDoubling(strings[k], out, ws);
+            }
+        }
+    });
+    return result;
+}
+
+// One string per line; a final line without '\n' counts as well
+vector<string_view> splitLines(string_view text) {
+    vector<string_view> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == string_view::npos) end = text.size();
+        lines.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    bool bench = argc > 1 && string(argv[1]) == "bench";
+    int arg = bench ? 2 : 1;
+    int threads = argc > arg ? atoi(argv[arg]) : (int)thread::hardware_concurrency();
+    int threshold = argc > arg + 1 ? atoi(argv[arg + 1]) : 24;
+    ThreadPool pool(threads);
+    vector<Workspace> workspaces(pool.size());
+
+    InputText input;
+    if (!input.open("-")) {
+        cerr << "cannot read stdin" << endl;
+        return 1;
+    }
+    vector<string_view> strings = splitLines(input.view());
+    long long bytes = 0;
+    for (auto s : strings) bytes += s.size();
+
+    auto wallSince = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    clock_t z = clock();
+    auto start = chrono::steady_clock::now();
+    BatchSuffixArrays result = buildSuffixArrays(strings, pool, workspaces, threshold);
+    double wall = wallSince(start), cpu = (double)(clock() - z) / CLOCKS_PER_SEC;
+
+    if (bench) {
+        // Per-call baseline on one thread, checked against the batch result
+        start = chrono::steady_clock::now();
+        bool same = true;
+        for (int k = 0; k < (int)strings.size(); k++) {
+            vector<int> suffixArray = buildSuffixArray(strings[k]);
+            same = same && equal(suffixArray.begin(), suffixArray.end(), result.begin(k));
+        }
+        double baseline = wallSince(start);
+        cerr << "Per-call : " << strings.size() / max(baseline, 1e-9) << " strings/s"
+             << ", Wall Time : " << baseline << endl;
+        cerr << "Match : " << (same ? "yes" : "NO") << endl;
+    } else {
+        for (int k = 0; k < (int)strings.size(); k++) {
+            for (const int *p = result.begin(k); p != result.end(k); p++) cout << *p << " ";
+            cout << '\n';
+        }
+    }
+
+    cerr << "Strings : " << strings.size() << ", Bytes : " << bytes
+         << ", Threads : " << pool.size() << ", Threshold : " << threshold << endl;
+    cerr << "Batch : " << strings.size() / max(wall, 1e-9) << " strings/s"
+         << ", Wall Time : " << wall
+         << ", CPU Time : " << cpu << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,429 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Suffix Array + LCP over 2-bit Packed DNA
+ *
+ *    Description:
+ *    Nucleotide text stored one byte per base wastes 6 of every 8 bits, and
+ *    the byte builders widen it again into an int per symbol. Here the text
+ *    is packed 32 bases per 64-bit word and never unpacked:
+ *      - SA-IS reads symbols straight from the packed words (inducedSort is
+ *        templated on the text type; only the reduced strings of the
+ *        recursion are int arrays),
+ *      - Kasai compares the 2-bit codes base by base, up to a bound set once
+ *        per suffix by the next N on either side.
+ *    Explicit handling of everything that is not A, C, G or T:
+ *      - N (and any other IUPAC code) is stored as A in the base words and
+ *        kept in a sorted list of runs. N sorts between G and T, as in the
+ *        byte order, so the SA equals the byte builders' SA, but N never
+ *        matches anything, itself included, so no LCP (and no match) runs
+ *        through an N.
+ *      - FASTA headers ('>' lines) and whitespace are skipped, lowercase
+ *        (soft-masked) bases are read as uppercase, and consecutive records
+ *        are joined by one N, so nothing matches across two records.
+ *      - The sentinel is the end of the text: a suffix that runs out is
+ *        smaller than every extension (virtual sentinel in SA-IS, explicit
+ *        length bound in Kasai); no symbol code is spent on it.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall DNA_Suffix_Array.cpp -o dna_sa
+ *
+ *    Execution:
+ *         ./dna_sa [file|-]            SA and LCP of the sequence
+ *         ./dna_sa compare [file|-]    packed vs byte builders: memory, time, equality
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n + upper). `s` holds symbols in [0, upper]; the end of
+// the string acts as a virtual sentinel smaller than every symbol. Text is the packed
+// sequence (or a byte string) at the top level and vector<int> for the recursion.
+template <class Text>
+vector<int> inducedSort(const Text &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// --------------------------------------------------------------------
+// Packed sequence
+// --------------------------------------------------------------------
+/*
+   Base i lives in bits 63 - 2(i mod 32) .. 62 - 2(i mod 32) of word i / 32
+   (first base in the high bits). N positions are stored as A in the base
+   words and recorded in runs, so only a base that reads as A needs the
+   O(log runs) search; assemblies have few, long N runs, which keeps that
+   far below the n / 8 bytes a per-base N mask would cost. Text with N's
+   scattered every few bases (hundreds of thousands of runs) makes the
+   search dominate SA-IS; the byte builders suit it better.
+*/
+class PackedDNA {
+public:
+    static const int N_SYMBOL = 3;
+
+    // Appends one FASTA byte: a base, an N-like code, or something skipped
+    void append(unsigned char c) {
+        if (atLineStart && c == '>') {
+            inHeader = true;
+            // One N between records, none before the first
+            if (n > 0) pendingSeparator = true;
+        }
+        atLineStart = c == '\n';
+        if (inHeader) {
+            if (c == '\n') inHeader = false;
+            return;
+        }
+        if (isspace(c)) return;
+        if (pendingSeparator) {
+            pendingSeparator = false;
+            push(4);
+        }
+        c = toupper(c);
+        push(c == 'A' ? 0 : c == 'C' ? 1 : c == 'G' ? 2 : c == 'T' ? 3 : 4);
+    }
+
+    int size() const { return n; }
+    bool hasN() const { return !runs.empty(); }
+    const vector<pair<int, int>> &nRuns() const { return runs; }      // [start, end)
+    size_t bytes() const { return bases.size() * sizeof(uint64_t) + runs.size() * sizeof(runs[0]); }
+
+    // SA-IS symbol in byte order: A C G N T -> 0 1 2 3 4
+    int operator[](int i) const {
+        int c = code(i);
+        if (c == 0 && isN(i)) return N_SYMBOL;
+        return c == 3 ? 4 : c;
+    }
+
+    // 2-bit code of base i (N reads as A)
+    int code(int i) const { return (bases[i >> 5] >> (62 - 2 * (i & 31))) & 3; }
+
+    bool isN(int i) const { return nextN(i) == i; }
+
+    // First N position at or after i, or size() if there is none
+    int nextN(int i) const {
+        auto it = upper_bound(runs.begin(), runs.end(), i, [](int x, const pair<int, int> &r) { return x < r.second; });
+        return it == runs.end() ? n : max(it->first, i);
+    }
+
+    char base(int i) const {
+        int c = code(i);
+        return c == 0 && isN(i) ? 'N' : "ACGT"[c];
+    }
+
+    // Trims the padding once the whole sequence is in
+    void finish() {
+        bases.resize((n + 31) / 32);
+        bases.shrink_to_fit();
+        runs.shrink_to_fit();
+    }
+
+private:
+    // code 0..3 for A, C, G, T, 4 for N
+    void push(int code) {
+        if ((n >> 5) >= (int)bases.size()) bases.resize(max<size_t>(1, bases.size() * 2));
+        if (code == 4) {
+            if (runs.empty() || runs.back().second != n) runs.push_back({n, n});
+            runs.back().second++;
+        } else {
+            bases[n >> 5] |= (uint64_t)code << (62 - 2 * (n & 31));
+        }
+        n++;
+    }
+
+    vector<uint64_t> bases;
+    vector<pair<int, int>> runs;
+    int n = 0;
+    bool atLineStart = true, inHeader = false, pendingSeparator = false;
+};
+
+// Function to build the suffix array of the packed sequence with SA-IS, O(n)
+vector<int> buildSuffixArray(const PackedDNA &dna) { return inducedSort(dna, 4); }
+
+// Function to build the LCP array using Kasai's algorithm on the 2-bit codes
+/*
+   The match of suffixes i and j can run up to the first N of either side or
+   the end of the shorter one; that bound is found once per suffix, and the
+   loop itself only compares codes. Kasai compares fewer than 2n bases in
+   total, a few per suffix, so comparing 32 bases per step with XORed
+   64-bit windows measured no faster than this loop, on random text and on
+   long repeats alike. Unpacking the codes costs 10-40% over the byte
+   builder when the text fits in cache; what packing buys is a text 4x
+   smaller.
+*/
+vector<int> buildLCPArray(const PackedDNA &dna, const vector<int> &suffixArray) {
+    int n = dna.size();
+    bool hasN = dna.hasN();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            int limit = n - max(i, j);
+            if (hasN) limit = min({limit, dna.nextN(i + h) - i, dna.nextN(j + h) - j});
+            while (h < limit && dna.code(i + h) == dna.code(j + h)) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+// --------------------------------------------------------------------
+// Byte builders, for comparison: the same sequence one char per base
+// --------------------------------------------------------------------
+vector<int> buildSuffixArray(const string &s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Kasai byte by byte, with the same rule that N never matches
+vector<int> buildLCPArray(const string &s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h] && s[i + h] != 'N') {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+double secondsSince(clock_t start) { return (double)(clock() - start) / CLOCKS_PER_SEC; }
+
+// Packed vs byte builders on the same sequence
+int compareMode(const PackedDNA &dna) {
+    int n = dna.size();
+    string s(n, 'A');
+    for (int i = 0; i < n; ++i) s[i] = dna.base(i);
+
+    clock_t z = clock();
+    vector<int> packedSA = buildSuffixArray(dna);
+    double packedSATime = secondsSince(z);
+    z = clock();
+    vector<int> packedLCP = buildLCPArray(dna, packedSA);
+    double packedLCPTime = secondsSince(z);
+
+    z = clock();
+    vector<int> byteSA = buildSuffixArray(s);
+    double byteSATime = secondsSince(z);
+    z = clock();
+    vector<int> byteLCP = buildLCPArray(s, byteSA);
+    double byteLCPTime = secondsSince(z);
+
+    long long lcpSum = accumulate(packedLCP.begin(), packedLCP.end(), 0LL);
+    cout << "Bases : " << n << ", N runs : " << dna.nRuns().size() << ", Mean LCP : " << (n ? (double)lcpSum / n : 0)
+         << '\n';
+    cout << fixed << setprecision(3);
+    cout << setw(8) << "" << setw(14) << "text bytes" << setw(14) << "SA-IS s" << setw(14) << "Kasai s" << '\n';
+    cout << setw(8) << "packed" << setw(14) << dna.bytes() << setw(14) << packedSATime << setw(14) << packedLCPTime << '\n';
+    cout << setw(8) << "byte" << setw(14) << s.size() << setw(14) << byteSATime << setw(14) << byteLCPTime << '\n';
+    bool same = packedSA == byteSA && packedLCP == byteLCP;
+    cout << (same ? "SA and LCP identical" : "MISMATCH between packed and byte builders") << endl;
+    return same ? 0 : 1;
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    bool compare = argc > 1 && string(argv[1]) == "compare";
+    const char *path = argc > 1 + compare ? argv[1 + compare] : "-";
+    InputText input;
+    if (!input.open(path)) {
+        cerr << "cannot read " << path << endl;
+        return 1;
+    }
+    if (input.size >= (size_t)INT_MAX) {
+        cerr << "sequence too long for 32-bit indices" << endl;
+        return 1;
+    }
+    PackedDNA dna;
+    for (size_t i = 0; i < input.size; ++i) dna.append(input.data[i]);
+    dna.finish();
+
+    if (compare) return compareMode(dna);
+
+    clock_t z = clock();
+    vector<int> suffixArray = buildSuffixArray(dna);
+    vector<int> lcpArray = buildLCPArray(dna, suffixArray);
+    double seconds = secondsSince(z);
+
+    for (int i = 0; i < dna.size(); ++i) cout << suffixArray[i] << " ";
+    cout << endl;
+    for (int i = 0; i < dna.size(); ++i) cout << lcpArray[i] << " ";
+    cout << endl;
+
+    cerr << "Bases : " << dna.size() << ", N runs : " << dna.nRuns().size() << ", Packed bytes : " << dna.bytes()
+         << ", Run Time : " << seconds << endl;
+    return 0;
+}
\ No newline at end of file
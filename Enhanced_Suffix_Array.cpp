@@ -0,0 +1,500 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Enhanced Suffix Array (child table, bottom-up LCP-interval traversal)
+ *
+ *    Description:
+ *    An lcp-interval [lb..rb] with value l is a maximal range of the suffix
+ *    array whose suffixes share a prefix of length exactly l: every lcp
+ *    inside is >= l, at least one equals l, and both neighbours outside are
+ *    smaller. These intervals are the internal nodes of the suffix tree, so
+ *    SA + LCP + a child table answers suffix-tree questions without the tree:
+ *      - bottomUp(visit): visits every lcp-interval once, children before
+ *        parents, with one left-to-right pass over LCP, O(n).
+ *      - forEachChild(lb, rb, f): the child intervals of any lcp-interval,
+ *        O(1) per child through the child table.
+ *      - find(p): the interval of pattern p, walked top-down through the
+ *        child table.
+ *    On top of the traversal the program mines maximal repeats (left- and
+ *    right-maximal) and supermaximal repeats (not contained in any other
+ *    repeat).
+ *
+ *    Input: the whole of stdin is the text; patterns come from the command line.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Enhanced_Suffix_Array.cpp -o esa
+ *
+ *    Execution:
+ *         ./esa <min-length> [patterns...] < corpus.txt
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Function to build the LCP array using Kasai's algorithm
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// --------------------------------------------------------------------
+// Enhanced suffix array: SA + LCP + child table
+// --------------------------------------------------------------------
+/*
+   L(i) is lcp[i] for 0 < i < n and -1 at both ends, so the whole array is
+   closed on both sides. For an lcp-interval [lb..rb] the l-indices are the
+   positions i in (lb..rb] with L(i) = l; they split the interval into its
+   children. The child table (Abouelhoda, Kurtz, Ohlebusch) stores three
+   pointers per position:
+       up[i]    first l-index of the interval that ends at i - 1,
+       down[i]  first l-index of the interval that starts at i,
+       nextl[i] next l-index after i in the same interval.
+   up[i] is only defined when L(i - 1) > L(i), down[i] and nextl[i] only
+   when L(i) <= L(i + 1), and down[i] is only ever read when nextl[i] is
+   undefined, so all three fit in one int per position: slot i - 1 holds
+   up[i], slot i holds nextl[i] or else down[i], and the lcp values tell
+   them apart. 0 means undefined (no pointer can be 0 since L(0) = -1).
+*/
+class EnhancedSuffixArray {
+public:
+    struct Interval {
+        int lcp, lb, rb;
+        int childIntervals;     // children that are intervals, not single suffixes
+    };
+
+    EnhancedSuffixArray(string_view text) : s(text), n(text.size()) {
+        suffixArray = buildSuffixArray(s);
+        lcp = buildLCPArray(s, suffixArray);
+        buildChildTable();
+    }
+
+    int size() const { return n; }
+    int suffix(int rank) const { return suffixArray[rank]; }
+    int L(int i) const { return i > 0 && i < n ? lcp[i] : -1; }
+
+    // Bottom-up traversal over every lcp-interval, children before parents
+    /*
+       leaf(rank) makes the value of a single suffix, merge(parent, child)
+       folds a child (leaf or interval) into its parent, and visit(interval,
+       value) is called once per lcp-interval with the value of all of its
+       suffixes. Nothing is allocated per child: the stack holds one entry
+       per open interval, and since their lcp values strictly increase from
+       bottom to top it never grows beyond maxLcp + 2 entries.
+    */
+    template <class Leaf, class Merge, class Visit>
+    int bottomUp(Leaf leaf, Merge merge, Visit visit) const {
+        using Value = decltype(leaf(0));
+        struct Open {
+            int lcp, lb, childIntervals;
+            Value value;
+        };
+        vector<Open> stack;
+        stack.push_back({-1, 0, 0, Value()});
+        int maxDepth = 1;
+
+        for (int i = 1; i <= n; ++i) {
+            int cur = L(i);
+            Value carry = leaf(i - 1);
+            bool carryIsInterval = false;
+            int lb = i - 1;
+            while (cur < stack.back().lcp) {
+                Open top = move(stack.back());
+                stack.pop_back();
+                merge(top.value, carry);
+                top.childIntervals += carryIsInterval;
+                visit(Interval{top.lcp, top.lb, i - 1, top.childIntervals}, top.value);
+                lb = top.lb;
+                carry = move(top.value);
+                carryIsInterval = true;
+            }
+            if (cur == stack.back().lcp) {
+                merge(stack.back().value, carry);
+                stack.back().childIntervals += carryIsInterval;
+            } else {
+                stack.push_back({cur, lb, carryIsInterval, move(carry)});
+                maxDepth = max(maxDepth, (int)stack.size());
+            }
+        }
+        return maxDepth;
+    }
+
+    // lcp value of the interval [lb..rb]; for a single suffix, its length
+    int intervalLcp(int lb, int rb) const {
+        if (lb == rb) return n - suffixArray[lb];
+        return L(firstLIndex(lb, rb));
+    }
+
+    // Calls f(childLb, childRb) for every child of the lcp-interval [lb..rb], left to right
+    template <class F>
+    void forEachChild(int lb, int rb, F f) const {
+        if (lb >= rb) return;
+        int i = firstLIndex(lb, rb);
+        f(lb, i - 1);
+        for (int next; (next = nextl(i)) != 0; i = next) {
+            f(i, next - 1);
+        }
+        f(i, rb);
+    }
+
+    // Smallest interval (lcp-interval or single suffix) whose suffixes all start with p; {-1, -1} if none
+    pair<int, int> find(string_view p) const {
+        int m = p.size();
+        if (n == 0) return {-1, -1};
+        int lb = 0, rb = n - 1, depth = 0;
+        while (true) {
+            int l = min(intervalLcp(lb, rb), m);
+            int start = suffixArray[lb];
+            for (int k = depth; k < l; ++k) {
+                if (s[start + k] != p[k]) return {-1, -1};
+            }
+            if (l == m) return {lb, rb};
+            depth = l;
+            // Children differ at offset l; only the first one can end there
+            int childLb = -1, childRb = -1;
+            forEachChild(lb, rb, [&](int clb, int crb) {
+                int q = suffixArray[clb] + l;
+                if (childLb == -1 && q < n && s[q] == p[l]) {
+                    childLb = clb;
+                    childRb = crb;
+                }
+            });
+            if (childLb == -1) return {-1, -1};
+            lb = childLb;
+            rb = childRb;
+        }
+    }
+
+private:
+    // Two stack passes over L(0..n); every index is pushed and popped once
+    void buildChildTable() {
+        child.assign(n + 1, 0);
+        vector<int> stack = {0};
+        int lastIndex = -1;
+        for (int i = 1; i <= n; ++i) {
+            while (L(i) < L(stack.back())) {
+                lastIndex = stack.back();
+                stack.pop_back();
+                int top = stack.back();
+                if (L(i) <= L(top) && L(top) != L(lastIndex)) {
+                    child[top] = lastIndex;     // down[top]
+                }
+            }
+            if (lastIndex != -1) {
+                child[i - 1] = lastIndex;       // up[i]
+                lastIndex = -1;
+            }
+            stack.push_back(i);
+        }
+
+        // nextl overwrites down where both exist
+        stack.assign(1, 0);
+        for (int i = 1; i < n; ++i) {
+            while (L(i) < L(stack.back())) stack.pop_back();
+            if (L(i) == L(stack.back())) {
+                child[stack.back()] = i;
+                stack.pop_back();
+            }
+            stack.push_back(i);
+        }
+    }
+
+    int up(int i) const { return L(i - 1) > L(i) ? child[i - 1] : 0; }
+    int down(int i) const { return L(i + 1) > L(i) && L(child[i]) > L(i) ? child[i] : 0; }
+    int nextl(int i) const { return L(i + 1) >= L(i) && child[i] != 0 && L(child[i]) == L(i) ? child[i] : 0; }
+
+    int firstLIndex(int lb, int rb) const {
+        int i = up(rb + 1);
+        return lb < i && i <= rb ? i : down(lb);
+    }
+
+    string_view s;
+    int n;
+    vector<int> suffixArray, lcp, child;
+};
+
+// --------------------------------------------------------------------
+// Maximal and supermaximal repeats
+// --------------------------------------------------------------------
+/*
+   Every lcp-interval is right-maximal: its children continue with
+   different characters. It is a maximal repeat when it is left-maximal
+   too, i.e. its suffixes are not all preceded by the same character (a
+   suffix at position 0 has no left character and counts as different
+   from all). A supermaximal repeat additionally occurs in no longer
+   repeat: its interval is a local maximum (no child intervals) and the
+   left characters of its suffixes are pairwise distinct. Local maxima
+   are disjoint, so checking their suffixes directly costs O(n) in total.
+*/
+const int LEFT_DIVERSE = 256;
+
+struct RepeatStats {
+    long long intervals = 0, maximal = 0, supermaximal = 0;
+    int maxDepth = 0;
+};
+
+RepeatStats findRepeats(string_view s, const EnhancedSuffixArray &esa, int minLength, ostream &out) {
+    RepeatStats stats;
+    auto leftChar = [&](int rank) -> int {
+        int p = esa.suffix(rank);
+        return p == 0 ? LEFT_DIVERSE : (unsigned char)s[p - 1];
+    };
+    auto merge = [](int &parent, int child) {
+        if (parent != child) parent = LEFT_DIVERSE;
+    };
+    bitset<257> seen;
+    stats.maxDepth = esa.bottomUp(leftChar, merge, [&](const EnhancedSuffixArray::Interval &v, int left) {
+        stats.intervals++;
+        if (v.lcp == 0 || left != LEFT_DIVERSE) return;
+        stats.maximal++;
+        bool super = v.childIntervals == 0;
+        if (super) {
+            seen.reset();
+            for (int r = v.lb; r <= v.rb && super; ++r) {
+                int c = leftChar(r);
+                super = c == LEFT_DIVERSE || !seen[c];
+                seen[c] = true;
+            }
+        }
+        stats.supermaximal += super;
+        if (v.lcp >= minLength) {
+            out << (super ? 'S' : 'M') << ' ' << v.lcp << ' ' << v.rb - v.lb + 1 << ' ' << esa.suffix(v.lb) << '\n';
+        }
+    });
+    return stats;
+}
+
+/*
+   Output: one line per maximal repeat of length >= min-length,
+       M|S <length> <occurrences> <one position>     (S if supermaximal)
+   then the totals, then for every pattern its interval and child intervals:
+       <pattern>: [lb..rb] lcp=<l> children: [lb..rb] ...
+*/
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <min-length> [patterns...] < input.txt" << endl;
+        return 1;
+    }
+    int minLength = max(1, atoi(argv[1]));
+    InputText input;
+    if (!input.open("-")) {
+        cerr << "cannot read stdin" << endl;
+        return 1;
+    }
+    string_view s = input.view();
+    if (s.size() >= (size_t)INT_MAX) {
+        cerr << "text too long for 32-bit indices" << endl;
+        return 1;
+    }
+
+    clock_t z = clock();
+    EnhancedSuffixArray esa(s);
+    double buildTime = (double)(clock() - z) / CLOCKS_PER_SEC;
+
+    z = clock();
+    RepeatStats stats = findRepeats(s, esa, minLength, cout);
+    double mineTime = (double)(clock() - z) / CLOCKS_PER_SEC;
+    cout << "Intervals : " << stats.intervals << ", Maximal repeats : " << stats.maximal
+         << ", Supermaximal repeats : " << stats.supermaximal << '\n';
+
+    for (int a = 2; a < argc; a++) {
+        auto [lb, rb] = esa.find(argv[a]);
+        cout << argv[a] << ':';
+        if (lb == -1) {
+            cout << " not found\n";
+            continue;
+        }
+        cout << " [" << lb << ".." << rb << "] lcp=" << esa.intervalLcp(lb, rb) << " children:";
+        esa.forEachChild(lb, rb, [&](int clb, int crb) { cout << " [" << clb << ".." << crb << "]"; });
+        cout << '\n';
+    }
+    cout << flush;
+
+    cerr << "Length : " << esa.size() << ", Max stack : " << stats.maxDepth << ", Build Time : " << buildTime
+         << ", Mining Time : " << mineTime << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,450 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: External-Memory Suffix Array and LCP Array
+ *
+ *    Description:
+ *    Builds the same suffix array and LCP array as lcp+suffix.cpp for texts
+ *    that do not fit in RAM. Nothing of size n is ever held in memory: every
+ *    array lives in a temporary file and is only read or written sequentially,
+ *    and every reordering goes through an external merge sort whose sorted
+ *    runs are bounded by a configurable memory budget.
+ *
+ *    Suffix array (prefix doubling with external sorting):
+ *      - names[i] is the rank of the first 2^k characters of suffix i, stored
+ *        densely in text order, so names[i + 2^k] is just a second cursor into
+ *        the same file, 2^k records ahead.
+ *      - Sort the triples (names[i], names[i + 2^k], i) by name pair. Their
+ *        order is the order of the first 2^(k+1) characters; renaming them
+ *        with dense ranks and sorting back by i gives the next names file.
+ *      - Stop once all names are distinct: the sorted triple order is the SA.
+ *
+ *    LCP array (Phi / PLCP, all streaming):
+ *      - Sort (SA[r], SA[r-1]) by SA[r]: the Phi array in text order.
+ *      - Scan i in text order, comparing suffix i with suffix Phi[i]; the
+ *        bound PLCP[i+1] >= PLCP[i] - 1 keeps the scan linear.
+ *      - Sort (SA[r], r) by SA[r], join with PLCP, sort back by r: LCP[r].
+ *    The comparisons read the text through a read-only memory map of the
+ *    input file (or of stdin spooled to disk), so pages come and go as the
+ *    OS sees fit.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall External_Suffix_Array.cpp -o external_sa
+ *
+ *    Execution:
+ *         ./external_sa [-m memory (e.g. 512M, 8G)] [-t tempdir] < input.txt     (first word of stdin)
+ *         ./external_sa [-m memory] [-t tempdir] corpus.bin|-                 (every byte of the file)
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+typedef unsigned long long u64;
+
+// --------------------------------------------------------------------
+// Temporary files: created in the configured directory, unlinked at once
+// --------------------------------------------------------------------
+string tempDir = "/tmp";
+
+struct TempFile {
+    FILE *f = nullptr;
+
+    TempFile() {
+        string path = tempDir + "/external_sa.XXXXXX";
+        vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+        int fd = mkstemp(name.data());
+        if (fd < 0) {
+            cerr << "cannot create a temporary file in " << tempDir << endl;
+            exit(1);
+        }
+        unlink(name.data());
+        f = fdopen(fd, "w+b");
+    }
+
+    ~TempFile() { fclose(f); }
+};
+
+typedef shared_ptr<TempFile> TempFilePtr;
+
+const size_t IO_BUFFER_BYTES = 1 << 20;
+
+// Buffered sequential writer of fixed-size records
+template <class T>
+struct RecordWriter {
+    TempFilePtr file;
+    vector<T> buffer;
+
+    explicit RecordWriter(TempFilePtr file) : file(file) {
+        buffer.reserve(max<size_t>(1, IO_BUFFER_BYTES / sizeof(T)));
+    }
+
+    void write(const T &x) {
+        buffer.push_back(x);
+        if (buffer.size() == buffer.capacity()) flush();
+    }
+
+    void flush() {
+        if (!buffer.empty() && fwrite(buffer.data(), sizeof(T), buffer.size(), file->f) != buffer.size()) {
+            cerr << "write to temporary file failed" << endl;
+            exit(1);
+        }
+        buffer.clear();
+    }
+
+    // Flushes and hands the file over for reading
+    TempFilePtr finish() {
+        flush();
+        fflush(file->f);
+        return file;
+    }
+};
+
+// Buffered sequential reader of fixed-size records, starting at record `skip`
+template <class T>
+struct RecordReader {
+    TempFilePtr file;
+    vector<T> buffer;
+    size_t next = 0;
+    u64 offset;
+
+    RecordReader(TempFilePtr file, u64 skip = 0, size_t bufferBytes = IO_BUFFER_BYTES)
+        : file(file), buffer(max<size_t>(1, bufferBytes / sizeof(T))), offset(skip * sizeof(T)) {
+        buffer.resize(0);
+    }
+
+    bool read(T &x) {
+        if (next == buffer.size()) {
+            // Several readers may share one file, so always seek to our own position
+            buffer.resize(buffer.capacity());
+            fseeko(file->f, offset, SEEK_SET);
+            size_t got = fread(buffer.data(), sizeof(T), buffer.size(), file->f);
+            buffer.resize(got);
+            offset += got * sizeof(T);
+            next = 0;
+            if (got == 0) return false;
+        }
+        x = buffer[next++];
+        return true;
+    }
+};
+
+// --------------------------------------------------------------------
+// External merge sort under a memory budget
+// --------------------------------------------------------------------
+/*
+   push() collects records until the budget is full, then sorts them and
+   writes a run. forEachSorted() merges the runs with a heap. Every run
+   holds a file descriptor, so runs are never allowed to pile up: as soon
+   as fanIn of them exist, the newest runs of the lowest merge level are
+   merged into one run of the next level, or all of them if that level
+   has a single run. Fewer than
+   fanIn runs are open at any time, so a build of any size needs a fixed
+   number of descriptors, and every record is still merged about
+   log_fanIn(runs) times. Inputs that fit in the budget never touch disk.
+*/
+size_t memoryBudget = 256ULL << 20;
+
+// Runs merged at once: as many 1 MB read buffers as fit in the budget, but at
+// least a few (smaller buffers) and at most MAX_FAN_IN, so that the two sorters
+// alive at a time stay well below the usual 1024 open-descriptor limit
+const size_t MIN_FAN_IN = 16, MAX_FAN_IN = 256;
+
+template <class T, class Less>
+struct ExternalSorter {
+    struct Run {
+        TempFilePtr file;
+        int level;   // number of merges its records went through
+    };
+
+    size_t budget, capacity, fanIn;
+    vector<T> buffer;
+    vector<Run> runs;   // levels never increase from front to back
+    Less less;
+
+    // Sorters that fill while another one drains are given half the budget each
+    explicit ExternalSorter(size_t budget = memoryBudget)
+        : budget(budget), capacity(max<size_t>(2, budget / sizeof(T))),
+          fanIn(clamp(budget / IO_BUFFER_BYTES, MIN_FAN_IN, MAX_FAN_IN)) {}
+
+    void push(const T &x) {
+        if (buffer.empty()) buffer.reserve(capacity);
+        buffer.push_back(x);
+        if (buffer.size() == capacity) flushRun();
+    }
+
+    void flushRun() {
+        sort(buffer.begin(), buffer.end(), less);
+        RecordWriter<T> writer(make_shared<TempFile>());
+        for (const T &x : buffer) writer.write(x);
+        runs.push_back({writer.finish(), 0});
+        buffer.clear();
+        if (runs.size() < fanIn) return;
+
+        // Cascade now rather than at the end; the record buffer is released
+        // first so the merge gets the whole budget (push() reserves it again)
+        vector<T>().swap(buffer);
+        size_t from = runs.size() - 1;
+        while (from > 0 && runs[from - 1].level == runs.back().level) from--;
+        if (from == runs.size() - 1) from = 0;
+        vector<TempFilePtr> group;
+        for (size_t i = from; i < runs.size(); i++) group.push_back(runs[i].file);
+        int level = runs[from].level + 1;
+        runs.resize(from);
+        RecordWriter<T> merged(make_shared<TempFile>());
+        mergeRuns(group, [&](const T &x) { merged.write(x); });
+        group.clear();
+        runs.push_back({merged.finish(), level});
+    }
+
+    template <class F>
+    void mergeRuns(const vector<TempFilePtr> &group, F emit) {
+        size_t readBytes = max<size_t>(sizeof(T), budget / (group.size() + 1));
+        vector<RecordReader<T>> readers;
+        for (auto &run : group) readers.emplace_back(run, 0, min(readBytes, IO_BUFFER_BYTES));
+        auto greater = [&](const pair<T, int> &a, const pair<T, int> &b) { return less(b.first, a.first); };
+        priority_queue<pair<T, int>, vector<pair<T, int>>, decltype(greater)> heap(greater);
+        T x;
+        for (int r = 0; r < (int)readers.size(); r++)
+            if (readers[r].read(x)) heap.push({x, r});
+        while (!heap.empty()) {
+            auto [top, r] = heap.top();
+            heap.pop();
+            emit(top);
+            if (readers[r].read(x)) heap.push({x, r});
+        }
+    }
+
+    // Calls f on every pushed record in sorted order; the sorter is consumed
+    template <class F>
+    void forEachSorted(F f) {
+        if (runs.empty()) {
+            sort(buffer.begin(), buffer.end(), less);
+            for (const T &x : buffer) f(x);
+            vector<T>().swap(buffer);
+            return;
+        }
+        if (!buffer.empty()) flushRun();
+        vector<T>().swap(buffer);
+
+        // flushRun() keeps fewer than fanIn runs, so one merge finishes the sort
+        vector<TempFilePtr> group;
+        for (auto &run : runs) group.push_back(run.file);
+        runs.clear();
+        mergeRuns(group, f);
+    }
+};
+
+// Records: (key, value) sorted by key, and (name pair, position) sorted by name pair
+struct KeyValue {
+    u64 key, value;
+};
+struct ByKey {
+    bool operator()(const KeyValue &a, const KeyValue &b) const { return a.key < b.key; }
+};
+
+struct NamePair {
+    u64 first, second, pos;
+};
+struct ByNames {
+    bool operator()(const NamePair &a, const NamePair &b) const {
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    }
+};
+
+// --------------------------------------------------------------------
+// Input: stdin spooled to disk, either whole or its first whitespace-delimited token
+// --------------------------------------------------------------------
+TempFilePtr spoolInput(u64 &n, bool whole) {
+    TempFilePtr file = make_shared<TempFile>();
+    vector<char> in(IO_BUFFER_BYTES), out;
+    out.reserve(IO_BUFFER_BYTES);
+    n = 0;
+    bool started = false, done = false;
+    size_t got;
+    while (!done && (got = fread(in.data(), 1, in.size(), stdin)) > 0) {
+        for (size_t i = 0; i < got; i++) {
+            bool space = !whole && isspace((unsigned char)in[i]);
+            if (!started && space) continue;
+            if (space) { done = true; break; }
+            started = true;
+            out.push_back(in[i]);
+        }
+        fwrite(out.data(), 1, out.size(), file->f);
+        n += out.size();
+        out.clear();
+    }
+    fflush(file->f);
+    return file;
+}
+
+// Function to build the suffix array; returns a file of n u64 positions in SA order
+TempFilePtr buildSuffixArrayExternal(const unsigned char *s, u64 n, int &rounds) {
+    // Names of the first character, in text order (0 is reserved for "past the end")
+    RecordWriter<u64> initial(make_shared<TempFile>());
+    for (u64 i = 0; i < n; i++) initial.write((u64)s[i] + 1);
+    TempFilePtr names = initial.finish();
+
+    rounds = 0;
+    for (u64 k = 1;; k *= 2) {
+        rounds++;
+        ExternalSorter<NamePair, ByNames> byNames(memoryBudget / 2);
+        RecordReader<u64> first(names), second(names, k);
+        for (u64 i = 0; i < n; i++) {
+            NamePair t = {0, 0, i};
+            first.read(t.first);
+            if (i + k < n) second.read(t.second);
+            byNames.push(t);
+        }
+
+        // Dense renaming in sorted order; the positions in this order are the candidate SA
+        ExternalSorter<KeyValue, ByKey> byPosition(memoryBudget / 2);
+        RecordWriter<u64> order(make_shared<TempFile>());
+        u64 distinct = 0;
+        NamePair prev = {0, 0, 0};
+        bool any = false;
+        byNames.forEachSorted([&](const NamePair &t) {
+            if (!any || t.first != prev.first || t.second != prev.second) distinct++;
+            any = true;
+            prev = t;
+            byPosition.push({t.pos, distinct});
+            order.write(t.pos);
+        });
+        if (distinct == n || k >= n) return order.finish();
+
+        RecordWriter<u64> next(make_shared<TempFile>());
+        byPosition.forEachSorted([&](const KeyValue &x) { next.write(x.value); });
+        names = next.finish();
+    }
+}
+
+// Function to build the LCP array from the SA file; returns n u64 values in SA order
+TempFilePtr buildLCPArrayExternal(const unsigned char *s, u64 n, TempFilePtr suffixArray) {
+    // Phi[SA[r]] = SA[r - 1], in text order; n marks the smallest suffix
+    ExternalSorter<KeyValue, ByKey> phi;
+    {
+        RecordReader<u64> sa(suffixArray);
+        u64 prev = n, p;
+        while (sa.read(p)) {
+            phi.push({p, prev});
+            prev = p;
+        }
+    }
+
+    // PLCP in text order
+    RecordWriter<u64> plcpWriter(make_shared<TempFile>());
+    u64 h = 0;
+    phi.forEachSorted([&](const KeyValue &x) {
+        u64 i = x.key, j = x.value;
+        if (j == n) h = 0;
+        else
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) ++h;
+        plcpWriter.write(h);
+        if (h > 0) --h;
+    });
+    TempFilePtr plcp = plcpWriter.finish();
+
+    // LCP[r] = PLCP[SA[r]]: sort ranks by position, join with PLCP, sort back by rank
+    ExternalSorter<KeyValue, ByKey> rankByPosition(memoryBudget / 2);
+    {
+        RecordReader<u64> sa(suffixArray);
+        u64 r = 0, p;
+        while (sa.read(p)) rankByPosition.push({p, r++});
+    }
+    ExternalSorter<KeyValue, ByKey> lcpByRank(memoryBudget / 2);
+    RecordReader<u64> plcpReader(plcp);
+    rankByPosition.forEachSorted([&](const KeyValue &x) {
+        u64 value = 0;
+        plcpReader.read(value);
+        lcpByRank.push({x.value, value});
+    });
+    RecordWriter<u64> lcp(make_shared<TempFile>());
+    lcpByRank.forEachSorted([&](const KeyValue &x) { lcp.write(x.value); });
+    return lcp.finish();
+}
+
+// Parses sizes such as 4096, 64K, 512M or 8G; returns 0 if text is not one
+size_t parseSize(const string &text) {
+    char *end;
+    if (text.empty() || !isdigit((unsigned char)text[0])) return 0;
+    size_t value = strtoull(text.c_str(), &end, 10);
+    string unit = end;
+    if (unit.empty()) return value;
+    if (unit.size() != 1) return 0;
+    switch (toupper(unit[0])) {
+        case 'K': return value << 10;
+        case 'M': return value << 20;
+        case 'G': return value << 30;
+        default: return 0;
+    }
+}
+
+int32_t main(int argc, char *argv[]) {
+    if (const char *dir = getenv("TMPDIR")) tempDir = dir;
+    const char *textPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag == "-m" && i + 1 < argc) {
+            memoryBudget = parseSize(argv[++i]);
+            if (memoryBudget == 0) {
+                cerr << "bad memory size " << argv[i] << " (expected e.g. 4096, 64K, 512M, 8G)" << endl;
+                return 1;
+            }
+        } else if (flag == "-t" && i + 1 < argc) tempDir = argv[++i];
+        else textPath = argv[i];
+    }
+
+    clock_t z = clock();
+    u64 n;
+    // A named file is mapped in place; stdin ("-" or no argument) is spooled first
+    TempFilePtr textFile;
+    int fd = -1;
+    if (textPath && string(textPath) != "-") {
+        struct stat st;
+        fd = open(textPath, O_RDONLY);
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            cerr << "cannot read " << textPath << endl;
+            return 1;
+        }
+        n = st.st_size;
+    } else {
+        textFile = spoolInput(n, textPath != nullptr);
+        fd = fileno(textFile->f);
+    }
+    const unsigned char *s = nullptr;
+    void *mapped = MAP_FAILED;
+    if (n > 0) {
+        mapped = mmap(nullptr, n, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            cerr << "cannot map the input" << endl;
+            return 1;
+        }
+        s = (const unsigned char *)mapped;
+    }
+
+    int rounds = 0;
+    TempFilePtr suffixArray = buildSuffixArrayExternal(s, n, rounds);
+    TempFilePtr lcpArray = buildLCPArrayExternal(s, n, suffixArray);
+
+    // Same output as lcp+suffix.cpp: n and the suffix array, then the LCP array
+    string line = to_string(n) + ' ';
+    fwrite(line.data(), 1, line.size(), stdout);
+    for (TempFilePtr file : {suffixArray, lcpArray}) {
+        RecordReader<u64> reader(file);
+        u64 x;
+        while (reader.read(x)) {
+            line = to_string(x) + ' ';
+            fwrite(line.data(), 1, line.size(), stdout);
+        }
+        fputc('\n', stdout);
+    }
+
+    if (mapped != MAP_FAILED) munmap(mapped, n);
+    if (!textFile) close(fd);
+    cerr << "Doubling Rounds : " << rounds << ", Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,493 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: FM-Index (BWT + wavelet tree) from the suffix array
+ *
+ *    Description:
+ *    A compressed self-index: the suffix array from buildSuffixArray gives
+ *    the Burrows-Wheeler transform of s$, which is stored in a wavelet tree
+ *    over rank/select bitvectors. Together with the C array this answers
+ *    count(P) by backward search in O(m log sigma) without the text or the
+ *    full suffix array. Every `rate`-th text position is kept as an SA
+ *    sample, so locate needs at most rate - 1 LF steps per occurrence.
+ *
+ *    Space: about log2(sigma) * 1.125 bits per character for the BWT, plus
+ *    32 / rate bits per character for the samples (versus 64 bits per
+ *    character for an int SA + LCP).
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall FM_Index.cpp -o fm_index
+ *
+ *    Execution:
+ *         ./fm_index [sample rate] < input.txt
+ *         input: the text (first word), then q and q patterns
+ *         ./fm_index <sample rate> corpus.bin < queries.txt  (every byte of the file)
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// --------------------------------------------------------------------
+// Bitvector with O(1) rank and O(log n) select
+// --------------------------------------------------------------------
+/*
+   Bits are packed into 64-bit words; blockRank[b] counts the ones before
+   every 512-bit block, so rank is one table lookup plus at most eight
+   popcounts (12.5% space overhead). select binary-searches the blocks and
+   then scans the words of one block.
+*/
+struct BitVector {
+    vector<uint64_t> words;
+    vector<uint64_t> blockRank;
+    uint64_t n = 0;
+
+    void init(uint64_t size) {
+        n = size;
+        words.assign((n + 63) / 64 + 1, 0);
+    }
+
+    void set(uint64_t i) { words[i >> 6] |= 1ULL << (i & 63); }
+    bool get(uint64_t i) const { return words[i >> 6] >> (i & 63) & 1; }
+
+    // Must be called once all bits are set
+    void buildRank() {
+        blockRank.assign(words.size() / 8 + 2, 0);
+        uint64_t ones = 0;
+        for (size_t w = 0; w < words.size(); w++) {
+            if (w % 8 == 0) blockRank[w / 8] = ones;
+            ones += __builtin_popcountll(words[w]);
+        }
+        blockRank[(words.size() + 7) / 8] = ones;
+    }
+
+    // Number of ones in [0, i)
+    uint64_t rank1(uint64_t i) const {
+        uint64_t w = i >> 6, r = blockRank[w >> 3];
+        for (uint64_t k = w & ~7ULL; k < w; k++) r += __builtin_popcountll(words[k]);
+        if (i & 63) r += __builtin_popcountll(words[w] & ((1ULL << (i & 63)) - 1));
+        return r;
+    }
+
+    uint64_t rank0(uint64_t i) const { return i - rank1(i); }
+
+    // Position of the k-th (0-based) one, or of the k-th zero when bit = 0
+    uint64_t select(bool bit, uint64_t k) const {
+        auto onesBefore = [&](uint64_t block) {
+            return bit ? blockRank[block] : min(n, block * 512) - blockRank[block];
+        };
+        uint64_t lo = 0, hi = (words.size() + 7) / 8;
+        while (hi - lo > 1) {
+            uint64_t mid = (lo + hi) / 2;
+            if (onesBefore(mid) <= k) lo = mid;
+            else hi = mid;
+        }
+        k -= onesBefore(lo);
+        for (uint64_t w = lo * 8;; w++) {
+            uint64_t word = bit ? words[w] : ~words[w];
+            uint64_t c = __builtin_popcountll(word);
+            if (k < c) {
+                while (k--) word &= word - 1;
+                return w * 64 + __builtin_ctzll(word);
+            }
+            k -= c;
+        }
+    }
+
+    size_t bytes() const { return (words.size() + blockRank.size()) * sizeof(uint64_t); }
+};
+
+// --------------------------------------------------------------------
+// Wavelet tree (level-wise "wavelet matrix" layout)
+// --------------------------------------------------------------------
+/*
+   Level l stores bit l (from the top) of every symbol, after the sequence
+   has been stably partitioned by the higher bits: zeros to the left, ones
+   to the right. Each level is one bitvector, so access, rank and select
+   cost one bitvector operation per level: O(log sigma).
+*/
+struct WaveletTree {
+    int levels = 0;
+    vector<BitVector> bits;
+    vector<uint64_t> zeros;
+
+    void build(vector<uint16_t> seq, int sigma) {
+        levels = 1;
+        while ((1 << levels) < sigma) levels++;
+        bits.assign(levels, BitVector());
+        zeros.assign(levels, 0);
+        uint64_t n = seq.size();
+        vector<uint16_t> left, right;
+        for (int l = 0; l < levels; l++) {
+            int shift = levels - 1 - l;
+            bits[l].init(n);
+            left.clear();
+            right.clear();
+            for (uint64_t i = 0; i < n; i++) {
+                if (seq[i] >> shift & 1) {
+                    bits[l].set(i);
+                    right.push_back(seq[i]);
+                } else {
+                    left.push_back(seq[i]);
+                }
+            }
+            bits[l].buildRank();
+            zeros[l] = left.size();
+            seq.swap(left);
+            seq.insert(seq.end(), right.begin(), right.end());
+        }
+    }
+
+    int access(uint64_t i) const {
+        int c = 0;
+        for (int l = 0; l < levels; l++) {
+            bool b = bits[l].get(i);
+            c = c << 1 | b;
+            i = b ? zeros[l] + bits[l].rank1(i) : bits[l].rank0(i);
+        }
+        return c;
+    }
+
+    // Occurrences of c in [0, i)
+    uint64_t rank(int c, uint64_t i) const {
+        uint64_t start = 0;
+        for (int l = 0; l < levels; l++) {
+            if (c >> (levels - 1 - l) & 1) {
+                start = zeros[l] + bits[l].rank1(start);
+                i = zeros[l] + bits[l].rank1(i);
+            } else {
+                start = bits[l].rank0(start);
+                i = bits[l].rank0(i);
+            }
+        }
+        return i - start;
+    }
+
+    // Position of the k-th (0-based) occurrence of c; k must be < rank(c, n)
+    uint64_t select(int c, uint64_t k) const {
+        uint64_t start = 0;
+        for (int l = 0; l < levels; l++) {
+            if (c >> (levels - 1 - l) & 1) start = zeros[l] + bits[l].rank1(start);
+            else start = bits[l].rank0(start);
+        }
+        uint64_t pos = start + k;
+        for (int l = levels - 1; l >= 0; l--) {
+            if (c >> (levels - 1 - l) & 1) pos = bits[l].select(1, pos - zeros[l]);
+            else pos = bits[l].select(0, pos);
+        }
+        return pos;
+    }
+
+    size_t bytes() const {
+        size_t total = zeros.size() * sizeof(uint64_t);
+        for (auto &b : bits) total += b.bytes();
+        return total;
+    }
+};
+
+// --------------------------------------------------------------------
+// FM-index over s$ built from the suffix array of s
+// --------------------------------------------------------------------
+/*
+   BWT[i] = character preceding the i-th smallest suffix of s$ ($ for the
+   suffix that starts the text). With C[c] = number of symbols smaller than
+   c, the rows prefixed by cP are C[c] + rank(c, rows prefixed by P), so
+   backward search counts a pattern with 2m rank queries and never reads s.
+
+   locate walks LF(i) = C[BWT[i]] + rank(BWT[i], i), i.e. one character
+   left in the text, until it reaches a row whose text position is a
+   multiple of the sampling rate; those positions are kept in `samples`,
+   in row order, and `sampled` marks their rows.
+*/
+struct FMIndex {
+    int code[256];          // byte -> symbol (1..sigma-1), 0 if absent; 0 is $
+    int sigma = 1;
+    vector<uint64_t> C;
+    WaveletTree bwt;
+    BitVector sampled;
+    vector<uint32_t> samples;
+    int sampleRate = 32;
+    uint64_t rows = 0;      // n + 1
+
+    void build(string_view s, int rate) {
+        sampleRate = rate;
+        uint64_t n = s.size();
+        rows = n + 1;
+
+        fill(code, code + 256, 0);
+        for (unsigned char ch : s) code[ch] = 1;
+        sigma = 1;
+        for (int ch = 0; ch < 256; ch++)
+            if (code[ch]) code[ch] = sigma++;
+
+        vector<int> suffixArray = buildSuffixArray(s);
+
+        // Row 0 is the suffix "$"; row r > 0 is suffixArray[r - 1]
+        vector<uint16_t> symbols(rows);
+        C.assign(sigma + 1, 0);
+        sampled.init(rows);
+        auto textPosition = [&](uint64_t r) -> uint64_t { return r == 0 ? n : suffixArray[r - 1]; };
+        for (uint64_t r = 0; r < rows; r++) {
+            uint64_t p = textPosition(r);
+            symbols[r] = p == 0 ? 0 : code[(unsigned char)s[p - 1]];
+            C[symbols[r] + 1]++;
+            if (p % sampleRate == 0) sampled.set(r);
+        }
+        for (int c = 0; c < sigma; c++) C[c + 1] += C[c];
+        sampled.buildRank();
+        for (uint64_t r = 0; r < rows; r++) {
+            uint64_t p = textPosition(r);
+            if (p % sampleRate == 0) samples.push_back(p);
+        }
+
+        vector<int>().swap(suffixArray);
+        bwt.build(move(symbols), sigma);
+    }
+
+    // Half-open row range of the suffixes prefixed by p (empty if none)
+    pair<uint64_t, uint64_t> backwardSearch(const string &p) const {
+        uint64_t sp = 0, ep = rows;
+        for (int i = (int)p.size() - 1; i >= 0 && sp < ep; i--) {
+            int c = code[(unsigned char)p[i]];
+            if (c == 0) return {0, 0};
+            sp = C[c] + bwt.rank(c, sp);
+            ep = C[c] + bwt.rank(c, ep);
+        }
+        return {sp, ep};
+    }
+
+    uint64_t count(const string &p) const {
+        auto [sp, ep] = backwardSearch(p);
+        return ep > sp ? ep - sp : 0;
+    }
+
+    // Text position of row r
+    uint64_t locateRow(uint64_t r) const {
+        uint64_t steps = 0;
+        while (!sampled.get(r)) {
+            int c = bwt.access(r);
+            r = C[c] + bwt.rank(c, r);
+            steps++;
+        }
+        return samples[sampled.rank1(r)] + steps;
+    }
+
+    // Starting positions of every occurrence of p, in increasing order
+    vector<uint64_t> locate(const string &p) const {
+        auto [sp, ep] = backwardSearch(p);
+        vector<uint64_t> positions;
+        for (uint64_t r = sp; r < ep; r++) positions.push_back(locateRow(r));
+        sort(positions.begin(), positions.end());
+        return positions;
+    }
+
+    size_t bytes() const {
+        return bwt.bytes() + sampled.bytes() + samples.size() * sizeof(uint32_t) + C.size() * sizeof(uint64_t);
+    }
+};
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// textPath: the text is every byte of that file ("-" for stdin); otherwise the first word of stdin
+void solve(int sampleRate, const char *textPath) {
+    FMIndex index;
+    {
+        // The text is released at the end of this block: queries never read it
+        InputText input;
+        string word;
+        string_view s;
+        if (textPath) {
+            if (!input.open(textPath)) {
+                cerr << "cannot read " << textPath << endl;
+                return;
+            }
+            s = input.view();
+        } else {
+            cin >> word;
+            s = word;
+        }
+        index.build(s, sampleRate);
+        cerr << "Text : " << s.size() << " bytes, FM-index : " << index.bytes()
+             << " bytes, SA + LCP would be : " << s.size() * 2 * sizeof(int) << " bytes" << endl;
+    }
+
+    // q, then q patterns; prints the count and the positions of each
+    int q;
+    if (!(cin >> q)) return;
+    while (q--) {
+        string p;
+        cin >> p;
+        vector<uint64_t> positions = index.locate(p);
+        cout << index.count(p) << ':';
+        for (uint64_t x : positions) cout << ' ' << x;
+        cout << '\n';
+    }
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    clock_t z = clock();
+    solve(argc > 1 ? max(1, atoi(argv[1])) : 32, argc > 2 ? argv[2] : nullptr);
+    cerr << "Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Generalized Suffix Array (many documents)
+ *
+ *    Description:
+ *    One suffix array over a whole collection of documents. The documents
+ *    are joined with unique separators, sorted with SA-IS over the integer
+ *    alphabet, and every SA slot records the document its suffix belongs to.
+ *    On top of that:
+ *      - listDocuments(p): the distinct documents that contain p, each one
+ *        reported once, in time proportional to the number reported
+ *        (Muthukrishnan's previous-occurrence array + RMQ).
+ *      - longestCommonSubstring(k): the longest substring that occurs in at
+ *        least k documents, by one sliding-window pass over SA and LCP.
+ *
+ *    Input: D, the D documents (whitespace separated), q, q patterns, k.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Generalized_Suffix_Array.cpp -o gsa
+ *
+ *    Execution:
+ *         ./gsa < input.txt
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// --------------------------------------------------------------------
+// Generalized suffix array over documents d_0 .. d_{D-1}
+// --------------------------------------------------------------------
+/*
+   The documents are concatenated as d_0 #_0 d_1 #_1 ... d_{D-1} #_{D-1}
+   over an integer alphabet: separator #_k is the symbol k and byte c is
+   D + c. Every separator is unique, so no common prefix can run across a
+   document boundary, and the separator suffixes sort first (ranks 0..D-1).
+   docOf[r] is the document that contains suffix SA[r].
+*/
+struct GeneralizedSuffixArray {
+    int numDocs = 0;
+    vector<int> text, suffixArray, lcp, docOf;
+    vector<int> separatorAt;            // text position of #_d
+    vector<int> prevSameDoc;            // previous SA slot from the same document, or -1
+    vector<vector<int>> prevMinPos;     // sparse table: argmin of prevSameDoc
+
+    void build(const vector<string> &docs) {
+        numDocs = docs.size();
+        vector<int> docAt;
+        for (int d = 0; d < numDocs; d++) {
+            for (unsigned char c : docs[d]) {
+                text.push_back(numDocs + c);
+                docAt.push_back(d);
+            }
+            separatorAt.push_back(text.size());
+            text.push_back(d);
+            docAt.push_back(d);
+        }
+        int n = text.size();
+        suffixArray = inducedSort(text, numDocs + 255);
+
+        // Kasai over the integer text; the unique separators end every match
+        vector<int> rank(n);
+        for (int r = 0; r < n; r++) rank[suffixArray[r]] = r;
+        lcp.assign(n, 0);
+        for (int i = 0, h = 0; i < n; i++) {
+            if (rank[i] == 0) { h = 0; continue; }
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && text[i + h] == text[j + h]) h++;
+            lcp[rank[i]] = h;
+            if (h > 0) h--;
+        }
+
+        docOf.resize(n);
+        prevSameDoc.resize(n);
+        vector<int> last(numDocs, -1);
+        for (int r = 0; r < n; r++) {
+            docOf[r] = docAt[suffixArray[r]];
+            prevSameDoc[r] = last[docOf[r]];
+            last[docOf[r]] = r;
+        }
+
+        prevMinPos.assign(1, vector<int>(n));
+        iota(prevMinPos[0].begin(), prevMinPos[0].end(), 0);
+        for (int k = 1; (1 << k) <= n; k++) {
+            const vector<int> &below = prevMinPos[k - 1];
+            vector<int> level(n - (1 << k) + 1);
+            for (int i = 0; i < (int)level.size(); i++) {
+                int a = below[i], b = below[i + (1 << (k - 1))];
+                level[i] = prevSameDoc[a] <= prevSameDoc[b] ? a : b;
+            }
+            prevMinPos.push_back(move(level));
+        }
+    }
+
+    // SA slot in [l, r] with the smallest prevSameDoc
+    int argminPrev(int l, int r) const {
+        int k = 31 - __builtin_clz(r - l + 1);
+        int a = prevMinPos[k][l], b = prevMinPos[k][r - (1 << k) + 1];
+        return prevSameDoc[a] <= prevSameDoc[b] ? a : b;
+    }
+
+    // Half-open SA range of the suffixes that start with p
+    pair<int, int> range(const string &p) const {
+        int n = text.size(), m = p.size();
+        auto compare = [&](int suffix) {
+            for (int k = 0; k < m; k++) {
+                if (suffix + k == n) return -1;
+                int c = numDocs + (unsigned char)p[k];
+                if (text[suffix + k] != c) return text[suffix + k] < c ? -1 : 1;
+            }
+            return 0;
+        };
+        int lo = 0, hi = n;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (compare(suffixArray[mid]) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        int first = lo;
+        hi = n;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (compare(suffixArray[mid]) <= 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return {first, lo};
+    }
+
+    // Distinct documents containing p, each reported once (Muthukrishnan)
+    /*
+       A slot r in [lo, hi) holds the first occurrence of its document in the
+       range exactly when prevSameDoc[r] < lo. The slot with the smallest
+       prevSameDoc is found by RMQ; if it qualifies it is reported and both
+       sides are searched, otherwise no slot in the range qualifies. The
+       work is O(number of documents reported), not O(occurrences).
+    */
+    vector<int> listDocuments(const string &p) const {
+        auto [lo, hi] = range(p);
+        vector<int> docs;
+        vector<pair<int, int>> stack;
+        if (lo < hi) stack.push_back({lo, hi - 1});
+        while (!stack.empty()) {
+            auto [l, r] = stack.back();
+            stack.pop_back();
+            int pos = argminPrev(l, r);
+            if (prevSameDoc[pos] >= lo) continue;
+            docs.push_back(docOf[pos]);
+            if (l < pos) stack.push_back({l, pos - 1});
+            if (pos < r) stack.push_back({pos + 1, r});
+        }
+        sort(docs.begin(), docs.end());
+        return docs;
+    }
+
+    // Longest substring shared by at least k documents; returns (length, text position)
+    /*
+       Slide a window over the SA slots (separator suffixes excluded) that
+       covers suffixes from at least k documents, keeping it as short as
+       possible. The longest prefix shared by every suffix in the window is
+       the minimum LCP inside it, maintained with a monotonic deque, so the
+       whole scan is O(n).
+    */
+    pair<int, int> longestCommonSubstring(int k) const {
+        int n = text.size();
+        pair<int, int> best = {0, 0};
+        if (k < 1 || k > numDocs) return best;
+        vector<int> inWindow(numDocs, 0);
+        deque<int> minLcp;  // SA slots in (l, r], increasing lcp
+        int distinct = 0, l = numDocs;
+        for (int r = numDocs; r < n; r++) {
+            if (inWindow[docOf[r]]++ == 0) distinct++;
+            if (r > l) {
+                while (!minLcp.empty() && lcp[minLcp.back()] >= lcp[r]) minLcp.pop_back();
+                minLcp.push_back(r);
+            }
+            while (distinct >= k) {
+                int shared = minLcp.empty() ? 0 : lcp[minLcp.front()];
+                // Single suffix (k == 1): all of it up to its separator
+                if (l == r) shared = separatorAt[docOf[r]] - suffixArray[r];
+                if (shared > best.first) best = {shared, suffixArray[r]};
+                if (--inWindow[docOf[l]] == 0) distinct--;
+                l++;
+                while (!minLcp.empty() && minLcp.front() <= l) minLcp.pop_front();
+            }
+        }
+        return best;
+    }
+
+    string substring(int pos, int len) const {
+        string out;
+        for (int i = 0; i < len; i++) out += (char)(text[pos + i] - numDocs);
+        return out;
+    }
+};
+
+void solve() {
+    // D documents, then q patterns, then k
+    int D;
+    cin >> D;
+    vector<string> docs(D);
+    for (auto &doc : docs) cin >> doc;
+
+    GeneralizedSuffixArray gsa;
+    gsa.build(docs);
+
+    int q;
+    if (!(cin >> q)) return;
+    while (q--) {
+        string p;
+        cin >> p;
+        vector<int> found = gsa.listDocuments(p);
+        cout << found.size() << ':';
+        for (int d : found) cout << ' ' << d;
+        cout << '\n';
+    }
+
+    int k;
+    if (!(cin >> k)) return;
+    auto [len, pos] = gsa.longestCommonSubstring(k);
+    cout << len << ' ' << gsa.substring(pos, len) << '\n';
+}
+
+int32_t main() {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    clock_t z = clock();
+    solve();
+    cerr << "Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
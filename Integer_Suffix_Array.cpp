@@ -0,0 +1,337 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Suffix Array over an Integer Alphabet (token / word-id sequences)
+ *
+ *    Description:
+ *    The string builders index bytes. Here the text is a sequence of 32-bit
+ *    token ids over an alphabet of size sigma (e.g. word ids of tokenized
+ *    text), so a phrase query is a search over a few tokens instead of the
+ *    several times longer byte string:
+ *      - SA-IS directly on the ids, buckets sized to sigma, O(n + sigma),
+ *      - prefix doubling (-DSA_DOUBLING) whose first counting-sort pass has
+ *        sigma + 1 buckets instead of 256,
+ *      - Kasai LCP in tokens and token-level phrase count/locate.
+ *
+ *    Input: N, N words, q, then q phrases given as "k w_1 .. w_k".
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Integer_Suffix_Array.cpp -o integer_sa
+ *
+ *    Execution:
+ *         ./integer_sa < input.txt
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n + upper). `s` holds symbols in [0, upper]; the end of
+// the string acts as a virtual sentinel smaller than every symbol. Symbol is the
+// token type at the top level and int for the reduced strings of the recursion.
+template <class Symbol>
+vector<int> inducedSort(const vector<Symbol> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// --------------------------------------------------------------------
+// Prefix doubling over tokens (suffix2.cpp generalised to an alphabet of size sigma)
+// --------------------------------------------------------------------
+/*
+   Same cyclic-shift counting sort as suffix2.cpp, with two changes for
+   token input: the first pass counts into sigma + 1 buckets (token t goes
+   to bucket t + 1, the virtual sentinel at position n to bucket 0), and
+   the later passes only need max(sigma + 1, n + 1) counters in total. The
+   returned array has no sentinel entry. O((n + sigma) log n).
+*/
+vector<int> buildSuffixArrayDoubling(const vector<uint32_t> &tokens, uint32_t sigma) {
+    int n = tokens.size() + 1;
+    vector<int> suffixArray(n), classes(n), cnt(max<size_t>((size_t)sigma + 1, n), 0);
+    auto firstKey = [&](int i) { return i == n - 1 ? 0 : (int)tokens[i] + 1; };
+
+    // Radix first pass sized to the alphabet
+    for (int i = 0; i < n; i++) cnt[firstKey(i)]++;
+    for (size_t c = 1; c <= sigma; c++) cnt[c] += cnt[c - 1];
+    for (int i = n - 1; i >= 0; i--) suffixArray[--cnt[firstKey(i)]] = i;
+
+    classes[suffixArray[0]] = 0;
+    int numClasses = 1;
+    for (int i = 1; i < n; i++) {
+        if (firstKey(suffixArray[i]) != firstKey(suffixArray[i - 1])) numClasses++;
+        classes[suffixArray[i]] = numClasses - 1;
+    }
+
+    // Iteratively sort by 2^k tokens, until every suffix has its own class
+    vector<int> tempSuffixArray(n), tempClasses(n);
+    for (int k = 0; (1 << k) < n && numClasses < n; k++) {
+        for (int i = 0; i < n; i++) {
+            tempSuffixArray[i] = suffixArray[i] - (1 << k);
+            if (tempSuffixArray[i] < 0) tempSuffixArray[i] += n;
+        }
+
+        fill(cnt.begin(), cnt.begin() + numClasses, 0);
+        for (int i = 0; i < n; i++) cnt[classes[tempSuffixArray[i]]]++;
+        for (int i = 1; i < numClasses; i++) cnt[i] += cnt[i - 1];
+        for (int i = n - 1; i >= 0; i--) suffixArray[--cnt[classes[tempSuffixArray[i]]]] = tempSuffixArray[i];
+
+        tempClasses[suffixArray[0]] = 0;
+        numClasses = 1;
+        for (int i = 1; i < n; i++) {
+            pair<int, int> curr = {classes[suffixArray[i]], classes[(suffixArray[i] + (1 << k)) % n]};
+            pair<int, int> prev = {classes[suffixArray[i - 1]], classes[(suffixArray[i - 1] + (1 << k)) % n]};
+            if (curr != prev) numClasses++;
+            tempClasses[suffixArray[i]] = numClasses - 1;
+        }
+        classes.swap(tempClasses);
+    }
+
+    suffixArray.erase(suffixArray.begin());
+    return suffixArray;
+}
+
+// Function to build the suffix array over tokens in [0, sigma) with SA-IS, O(n + sigma)
+vector<int> buildSuffixArraySAIS(const vector<uint32_t> &tokens, uint32_t sigma) {
+    return inducedSort(tokens, (int)sigma - 1);
+}
+
+// Function to build the suffix array over tokens
+vector<int> buildSuffixArray(const vector<uint32_t> &tokens, uint32_t sigma) {
+#ifdef SA_DOUBLING
+    return buildSuffixArrayDoubling(tokens, sigma);
+#else
+    return buildSuffixArraySAIS(tokens, sigma);
+#endif
+}
+
+// Function to build the LCP array (in tokens) using Kasai's algorithm
+vector<int> buildLCPArray(const vector<uint32_t> &tokens, const vector<int> &suffixArray) {
+    int n = tokens.size();
+    vector<int> rank(n), lcp(n);
+
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && tokens[i + h] == tokens[j + h]) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+// --------------------------------------------------------------------
+// Phrase search: a pattern is a token sequence, compared token by token
+// --------------------------------------------------------------------
+struct TokenSearcher {
+    const vector<uint32_t> &tokens;
+    const vector<int> &suffixArray;
+
+    // <0, 0, >0 as the suffix is below, starts with, or is above the phrase
+    int compare(int suffix, const vector<uint32_t> &phrase) const {
+        int n = tokens.size(), m = phrase.size();
+        for (int k = 0; k < m; k++) {
+            if (suffix + k == n) return -1;
+            if (tokens[suffix + k] != phrase[k]) return tokens[suffix + k] < phrase[k] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    // Half-open range of SA slots whose suffixes start with the phrase
+    pair<int, int> equalRange(const vector<uint32_t> &phrase) const {
+        int lo = 0, hi = suffixArray.size();
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (compare(suffixArray[mid], phrase) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        int first = lo;
+        hi = suffixArray.size();
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (compare(suffixArray[mid], phrase) <= 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return {first, lo};
+    }
+
+    int count(const vector<uint32_t> &phrase) const {
+        auto [lo, hi] = equalRange(phrase);
+        return hi - lo;
+    }
+
+    // Token positions of every occurrence, in increasing order
+    vector<int> locate(const vector<uint32_t> &phrase) const {
+        auto [lo, hi] = equalRange(phrase);
+        vector<int> positions(suffixArray.begin() + lo, suffixArray.begin() + hi);
+        sort(positions.begin(), positions.end());
+        return positions;
+    }
+};
+
+void solve() {
+    // N words of text; ids follow the sorted order of the distinct words, so
+    // the token-level SA lists word suffixes in dictionary order
+    int N;
+    cin >> N;
+    vector<string> words(N);
+    for (auto &w : words) cin >> w;
+    vector<string> vocabulary = words;
+    sort(vocabulary.begin(), vocabulary.end());
+    vocabulary.erase(unique(vocabulary.begin(), vocabulary.end()), vocabulary.end());
+    auto idOf = [&](const string &w) -> int64_t {
+        auto it = lower_bound(vocabulary.begin(), vocabulary.end(), w);
+        return it != vocabulary.end() && *it == w ? it - vocabulary.begin() : -1;
+    };
+    vector<uint32_t> tokens(N);
+    for (int i = 0; i < N; i++) tokens[i] = idOf(words[i]);
+    uint32_t sigma = max<size_t>(1, vocabulary.size());
+
+    vector<int> suffixArray = buildSuffixArray(tokens, sigma);
+    vector<int> lcpArray = buildLCPArray(tokens, suffixArray);
+
+    cout << N << ' ';
+    for (int i = 0; i < N; ++i) cout << suffixArray[i] << " ";
+    cout << endl;
+    for (int i = 0; i < N; ++i) cout << lcpArray[i] << " ";
+    cout << endl;
+
+    // q phrases, each "k w_1 .. w_k"; prints the count and the token positions
+    int q;
+    if (!(cin >> q)) return;
+    TokenSearcher searcher{tokens, suffixArray};
+    while (q--) {
+        int k;
+        cin >> k;
+        vector<uint32_t> phrase(k);
+        bool known = true;
+        for (auto &t : phrase) {
+            string w;
+            cin >> w;
+            int64_t id = idOf(w);
+            known = known && id >= 0;
+            t = id;
+        }
+        vector<int> positions = known ? searcher.locate(phrase) : vector<int>();
+        cout << positions.size() << ':';
+        for (int p : positions) cout << ' ' << p;
+        cout << '\n';
+    }
+}
+
+int32_t main() {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    clock_t z = clock();
+    solve();
+    cerr << "Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,694 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: LCP Array Construction (Kasai vs Phi / PLCP)
+ *
+ *    Description:
+ *    Kasai's algorithm (buildLCPArray) needs a full inverse suffix array
+ *    rank[] next to SA and LCP, and visits SA and LCP in rank order, i.e.
+ *    at random. The Phi / permuted-LCP approach computes the LCP values in
+ *    text order first and only then permutes them into SA order:
+ *      - buildLCPArrayPhi: Phi array overwritten in place by PLCP, one
+ *        sequential pass over it, then LCP[r] = PLCP[SA[r]].
+ *      - buildLCPArraySparsePhi: keeps PLCP for every q-th position only,
+ *        so the extra memory drops from n to n/q integers.
+ *      - buildLCPArrayParallel: the Phi builder split into T chunks of the
+ *        text that run on separate threads, each starting from its exact
+ *        PLCP value so that repetitive text does not serialize it.
+ *    The compare mode runs every builder in a separate process on the same
+ *    input and reports wall time and peak RSS.
+ *    All builders extend matches with mismatchLength, which compares 16/32
+ *    bytes per step with SSE2/AVX2; the simd mode measures its speed-up over
+ *    the byte-by-byte loop on texts of increasing repetitiveness.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall -pthread LCP_Construction.cpp -o lcp_construction
+ *
+ *    Execution:
+ *         ./lcp_construction [compare|kasai|phi|sparse] [q] [text-file|-] < input.txt
+ *         ./lcp_construction parallel [threads] [text-file|-] < input.txt
+ *         ./lcp_construction scaling [max threads] [text-file|-] < input.txt
+ *         (with a text file the text is every byte of it, otherwise the first word of stdin)
+ *         ./lcp_construction simd [n]
+ */
+
+#include <bits/stdc++.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// --------------------------------------------------------------------
+// Mismatch kernel: length of the common prefix of a[0..limit) and b[0..limit)
+// --------------------------------------------------------------------
+/*
+   The first 8 bytes are compared one at a time: most matches in an LCP
+   pass are short, and while the length is decided by branches the CPU
+   keeps speculating into the next suffix, overlapping its cache misses;
+   a wide compare would make the next address wait for this one's load.
+   Past that, 32 bytes (AVX2) or 16 bytes (SSE2) are compared per step: a
+   byte-wise equality compare becomes a bit mask and the first mismatch is
+   its lowest zero bit, found with ctz. Without either instruction set, 8
+   bytes are compared per step as 64-bit words (first differing byte =
+   ctz(x ^ y) / 8 on little-endian machines). SSE2 is always available on
+   x86-64; build with -mavx2 (or -march=native) for the AVX2 path.
+   Wide = false keeps the plain byte loop, for the benchmark below.
+*/
+template <bool Wide = true>
+inline int mismatchLength(const char *a, const char *b, int limit) {
+    int k = 0, head = Wide ? min(limit, 8) : limit;
+    while (k < head && a[k] == b[k]) ++k;
+    if (!Wide || k < head || k == limit) return k;
+#if defined(__AVX2__)
+    for (; k + 32 <= limit; k += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + k));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + k));
+        uint32_t equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFFFFFu) return k + __builtin_ctz(~equal);
+    }
+#elif defined(__SSE2__)
+    for (; k + 16 <= limit; k += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + k));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + k));
+        uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFu) return k + __builtin_ctz(~equal & 0xFFFFu);
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; k + 8 <= limit; k += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + k, 8);
+        memcpy(&y, b + k, 8);
+        if (x != y) return k + __builtin_ctzll(x ^ y) / 8;
+    }
+#endif
+    while (k < limit && a[k] == b[k]) ++k;
+    return k;
+}
+
+// Function to build the LCP array using Kasai's algorithm
+template <bool Wide = true>
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            h += mismatchLength<Wide>(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+// Function to build the LCP array with the Phi array / permuted LCP (PLCP)
+/*
+   Phi[SA[r]] = SA[r - 1] names, for every text position, the suffix just
+   before it in SA order. PLCP[i] = LCP(suffix i, suffix Phi[i]) is the LCP
+   array in text order, and PLCP[i + 1] >= PLCP[i] - 1, so one left-to-right
+   pass computes it with Kasai's amortization. Phi is overwritten by PLCP
+   in place and LCP[r] = PLCP[SA[r]] is gathered at the end. Unlike Kasai,
+   the main pass reads Phi and writes PLCP strictly sequentially.
+*/
+template <bool Wide = true>
+vector<int> buildLCPArrayPhi(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> plcp(n);
+    if (n == 0) return plcp;
+
+    // Phi, stored in the array that will hold PLCP
+    plcp[suffixArray[0]] = -1;
+    for (int r = 1; r < n; ++r) {
+        plcp[suffixArray[r]] = suffixArray[r - 1];
+    }
+
+    int h = 0;
+    for (int i = 0; i < n; ++i) {
+        int j = plcp[i];
+        if (j < 0) {
+            h = 0;
+        } else {
+            h += mismatchLength<Wide>(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+        }
+        plcp[i] = h;
+        if (h > 0) --h;
+    }
+
+    vector<int> lcp(n);
+    for (int r = 0; r < n; ++r) {
+        lcp[r] = plcp[suffixArray[r]];
+    }
+    return lcp;
+}
+
+// Function to build the LCP array with a sparse Phi array (every q-th text position)
+/*
+   Low-memory variant of the above: PLCP is only computed for positions
+   0, q, 2q, ... (n/q entries; PLCP[i + q] >= PLCP[i] - q keeps it linear).
+   The LCP array is then filled in SA order: for suffix i = kq + j,
+   PLCP[i] >= PLCP[kq] - j, so comparison starts from that bound. Apart
+   from the output, only n/q extra integers are allocated, and SA and LCP
+   are scanned sequentially; the price is up to q extra character
+   comparisons per suffix.
+*/
+template <bool Wide = true>
+vector<int> buildLCPArraySparsePhi(string_view s, const vector<int> &suffixArray, int q) {
+    int n = s.size();
+    int samples = (n + q - 1) / q;
+    vector<int> sparse(samples, -1);
+    for (int r = 1; r < n; ++r) {
+        if (suffixArray[r] % q == 0) sparse[suffixArray[r] / q] = suffixArray[r - 1];
+    }
+
+    int h = 0;
+    for (int k = 0; k < samples; ++k) {
+        int i = k * q, j = sparse[k];
+        if (j < 0) {
+            h = 0;
+        } else {
+            h += mismatchLength<Wide>(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+        }
+        sparse[k] = h;
+        h = max(0, h - q);
+    }
+
+    vector<int> lcp(n);
+    for (int r = 1; r < n; ++r) {
+        int i = suffixArray[r], j = suffixArray[r - 1];
+        int h = max(0, sparse[i / q] - i % q);
+        h += mismatchLength<Wide>(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+        lcp[r] = h;
+    }
+    return lcp;
+}
+
+double threadCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Runs f(t) for t in [0, T), t = 0 on the calling thread, and waits for all of them;
+// returns the largest CPU time a single f(t) took, i.e. the pass's critical path
+template <class F>
+double parallelFor(int T, F f) {
+    vector<double> cpu(T);
+    auto timed = [&](int t) {
+        double start = threadCpuSeconds();
+        f(t);
+        cpu[t] = threadCpuSeconds() - start;
+    };
+    vector<thread> workers;
+    for (int t = 1; t < T; t++) workers.emplace_back(timed, t);
+    timed(0);
+    for (auto &w : workers) w.join();
+    return *max_element(cpu.begin(), cpu.end());
+}
+
+// mismatchLength for possibly very long matches, compared by T threads
+/*
+   The first block is compared alone, which settles almost every call.
+   Past it, every round hands one block to each of the T threads, the
+   block size doubling from round to round, and the first block holding a
+   mismatch gives the answer. Blocks past the mismatch are wasted, but
+   never more than one round's worth, so L matching bytes cost O(L / T)
+   time plus one thread start per round, O(log L) rounds.
+*/
+const int COMPARE_BLOCK = 1 << 16;
+
+int parallelMismatchLength(const char *a, const char *b, int limit, int T) {
+    int first = min(limit, COMPARE_BLOCK);
+    int k = mismatchLength(a, b, first);
+    if (k < first || T == 1) return k < first ? k : k + mismatchLength(a + k, b + k, limit - k);
+    vector<long long> found(T);
+    for (long long block = COMPARE_BLOCK; k < limit; block *= 2) {
+        parallelFor(T, [&](int t) {
+            long long lo = k + t * block, hi = min<long long>(limit, lo + block);
+            found[t] = -1;
+            if (lo >= hi) return;
+            int m = mismatchLength(a + lo, b + lo, hi - lo);
+            if (lo + m < hi) found[t] = lo + m;
+        });
+        for (int t = 0; t < T; t++)
+            if (found[t] >= 0) return found[t];
+        k = min<long long>(limit, k + T * block);
+    }
+    return limit;
+}
+
+// Function to build the LCP array with T threads (parallel Phi / PLCP)
+/*
+   Every pass of buildLCPArrayPhi splits into independent chunks:
+     1. Phi[SA[r]] = SA[r - 1] over chunks of SA slots,
+     2. PLCP over T contiguous chunks of text positions,
+     3. LCP[r] = PLCP[SA[r]] over chunks of SA slots.
+   In pass 2 the amortization h >= PLCP[i - 1] - 1 links neighbouring
+   positions only, so a chunk may start at its first position lo if it
+   knows PLCP[lo]. Restarting from h = 0 would cost up to PLCP[lo] extra
+   comparisons per chunk, which on repetitive text ("aaaa...", long
+   repeated log lines) is Θ(n) and caps the speed-up near 2x. Instead,
+   pass 2 first computes the exact seeds PLCP[lo_t] in chunk order, each
+   starting from the bound PLCP[lo_{t-1}] - (lo_t - lo_{t-1}). Those
+   extensions add up to under 2n bytes, and a long one is split among the
+   threads (parallelMismatchLength). Then every chunk runs from its seed.
+   What remains sequential is a jump of PLCP inside one chunk: a chunk
+   that goes from small LCPs to an LCP of L compares those L bytes
+   itself, as sequential Kasai does. Each chunk reads and overwrites only
+   its own Phi entries, which keeps the in-place update race-free.
+   criticalPath, if given, receives the sum over the passes of the longest
+   per-thread CPU time (the seeds count on the calling thread): the wall
+   time the build would take with T idle cores.
+*/
+vector<int> buildLCPArrayParallel(string_view s, const vector<int> &suffixArray, int T,
+                                  double *criticalPath = nullptr) {
+    int n = s.size();
+    T = max(1, min(T, n));
+    vector<int> plcp(n), lcp(n);
+    if (n == 0) return lcp;
+    auto chunk = [&](int t) { return make_pair((int)((long long)n * t / T), (int)((long long)n * (t + 1) / T)); };
+
+    double critical = parallelFor(T, [&](int t) {
+        auto [lo, hi] = chunk(t);
+        for (int r = lo; r < hi; ++r) plcp[suffixArray[r]] = r > 0 ? suffixArray[r - 1] : -1;
+    });
+
+    // Exact PLCP at every chunk start, chained from the previous one
+    double seedStart = threadCpuSeconds();
+    vector<int> seed(T);
+    for (int t = 0; t < T; t++) {
+        int i = chunk(t).first, j = plcp[i];
+        int h = t == 0 ? 0 : max(0, seed[t - 1] - (i - chunk(t - 1).first));
+        seed[t] = j < 0 ? 0 : h + parallelMismatchLength(s.data() + i + h, s.data() + j + h, n - max(i, j) - h, T);
+    }
+    critical += threadCpuSeconds() - seedStart;
+
+    critical += parallelFor(T, [&](int t) {
+        auto [lo, hi] = chunk(t);
+        int h = seed[t];
+        for (int i = lo; i < hi; ++i) {
+            int j = plcp[i];
+            if (j < 0) {
+                h = 0;
+            } else {
+                h += mismatchLength(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+            }
+            plcp[i] = h;
+            if (h > 0) --h;
+        }
+    });
+
+    critical += parallelFor(T, [&](int t) {
+        auto [lo, hi] = chunk(t);
+        for (int r = lo; r < hi; ++r) lcp[r] = plcp[suffixArray[r]];
+    });
+    if (criticalPath) *criticalPath = critical;
+    return lcp;
+}
+
+// Wall time of buildLCPArrayParallel for T = 1, 2, 4, ..., maxThreads, against Kasai
+/*
+   The critical path column is the wall time T idle cores would need (see
+   buildLCPArrayParallel), so its speed-up column shows how the work is
+   balanced even on a machine with fewer cores than threads, where the
+   wall time cannot scale.
+*/
+void measureScaling(string_view s, const vector<int> &suffixArray, int maxThreads) {
+    auto time = [&](auto build) {
+        auto start = chrono::steady_clock::now();
+        vector<int> lcp = build();
+        return make_pair(chrono::duration<double>(chrono::steady_clock::now() - start).count(), lcp);
+    };
+    auto [kasaiTime, expected] = time([&] { return buildLCPArray(s, suffixArray); });
+    cout << left << setw(10) << "threads" << setw(12) << "time (s)" << setw(14) << "vs 1 thread"
+         << setw(10) << "vs Kasai" << setw(16) << "critical (s)" << setw(14) << "vs 1 thread" << "LCP" << endl;
+    double single = 0, singleCritical = 0;
+    for (int T = 1;; T = min(2 * T, maxThreads)) {
+        double critical = 0;
+        auto [seconds, lcp] = time([&] { return buildLCPArrayParallel(s, suffixArray, T, &critical); });
+        if (T == 1) single = seconds, singleCritical = critical;
+        cout << left << setw(10) << T << setw(12) << fixed << setprecision(3) << seconds
+             << setw(14) << setprecision(2) << single / max(seconds, 1e-9)
+             << setw(10) << kasaiTime / max(seconds, 1e-9) << setw(16) << setprecision(3) << critical
+             << setw(14) << setprecision(2) << singleCritical / max(critical, 1e-9)
+             << (lcp == expected ? "ok" : "MISMATCH") << endl;
+        if (T == maxThreads) break;
+    }
+}
+
+// --------------------------------------------------------------------
+// Measurement: every algorithm runs in its own forked child
+// --------------------------------------------------------------------
+/*
+   The parent builds the suffix array once and forks; each child inherits
+   the text and SA, runs one LCP builder, and reports a checksum through a
+   pipe. wait4() gives the child's peak RSS, so the numbers do not mix with
+   each other or with the SA construction. The "baseline" child runs no
+   builder; its peak is what every child starts from.
+*/
+struct Measurement {
+    double seconds;
+    long peakKB;
+    unsigned long long checksum;
+};
+
+template <class F>
+Measurement measureInChild(F build) {
+    int fds[2];
+    if (pipe(fds) != 0) { perror("pipe"); exit(1); }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        auto start = chrono::steady_clock::now();
+        vector<int> lcp = build();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        unsigned long long checksum = 0;
+        for (int x : lcp) checksum = checksum * 1000003 + x;
+        Measurement m = {seconds, 0, checksum};
+        if (write(fds[1], &m, sizeof m) != (ssize_t)sizeof m) _exit(1);
+        _exit(0);
+    }
+    close(fds[1]);
+    Measurement m = {0, 0, 0};
+    if (read(fds[0], &m, sizeof m) != (ssize_t)sizeof m) cerr << "child failed" << endl;
+    close(fds[0]);
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    m.peakKB = usage.ru_maxrss;
+    return m;
+}
+
+void compareBuilders(string_view s, const vector<int> &suffixArray, int q, int threads) {
+    vector<pair<string, function<vector<int>()>>> builders = {
+        {"baseline (text + SA)", [&] { return vector<int>(); }},
+        {"Kasai", [&] { return buildLCPArray(s, suffixArray); }},
+        {"Phi / PLCP", [&] { return buildLCPArrayPhi(s, suffixArray); }},
+        {"sparse Phi, q = " + to_string(q), [&] { return buildLCPArraySparsePhi(s, suffixArray, q); }},
+        {"parallel Phi x " + to_string(threads), [&] { return buildLCPArrayParallel(s, suffixArray, threads); }},
+    };
+
+    long baseline = 0;
+    unsigned long long expected = 0;
+    cout << left << setw(24) << "algorithm" << setw(12) << "time (s)" << setw(16) << "peak RSS (MB)"
+         << setw(16) << "over baseline" << "LCP" << endl;
+    for (auto &[name, build] : builders) {
+        Measurement m = measureInChild(build);
+        bool isBaseline = name.rfind("baseline", 0) == 0;
+        if (isBaseline) baseline = m.peakKB;
+        else if (expected == 0) expected = m.checksum;
+        cout << left << setw(24) << name << setw(12) << fixed << setprecision(3) << m.seconds
+             << setw(16) << setprecision(1) << m.peakKB / 1024.0
+             << setw(16) << (m.peakKB - baseline) / 1024.0
+             << (isBaseline ? "" : m.checksum == expected ? "ok" : "MISMATCH") << endl;
+    }
+}
+
+// --------------------------------------------------------------------
+// Mismatch kernel vs byte-by-byte comparison, by repetitiveness
+// --------------------------------------------------------------------
+/*
+   Texts of n bytes made of one random block of `period` bytes repeated
+   over and over, with every byte mutated with probability `mutation`.
+   Shorter periods and fewer mutations mean longer LCPs, i.e. longer runs
+   of equal bytes for the kernel to skip. Kasai and Phi compare fewer than
+   2n bytes in total whatever the text and are bound by cache misses, so
+   their gain is small; sparse Phi recompares up to q bytes per suffix and
+   gains the most.
+*/
+void benchmarkKernel(int n) {
+    struct Level { const char *name; int period; double mutation; };
+    vector<Level> levels = {
+        {"random", n, 0},
+        {"period 64K, 1% mutated", 1 << 16, 0.01},
+        {"period 64K, 0.1% mutated", 1 << 16, 0.001},
+        {"period 4K, 0.01% mutated", 1 << 12, 0.0001},
+        {"period 4K, exact repeats", 1 << 12, 0},
+    };
+    const int q = 32;
+    vector<tuple<string, vector<int> (*)(string_view, const vector<int> &),
+                 vector<int> (*)(string_view, const vector<int> &)>> builders = {
+        {"Kasai", buildLCPArray<false>, buildLCPArray<true>},
+        {"Phi / PLCP", buildLCPArrayPhi<false>, buildLCPArrayPhi<true>},
+        {"sparse Phi, q = 32",
+         [](string_view s, const vector<int> &sa) { return buildLCPArraySparsePhi<false>(s, sa, q); },
+         [](string_view s, const vector<int> &sa) { return buildLCPArraySparsePhi<true>(s, sa, q); }},
+    };
+
+    mt19937 rng(7);
+    cout << left << setw(28) << "text" << setw(12) << "mean LCP" << setw(22) << "algorithm"
+         << setw(14) << "bytewise (s)" << setw(14) << "kernel (s)" << "speed-up" << endl;
+    for (auto &level : levels) {
+        string block(level.period, 'a'), s(n, 'a');
+        for (auto &c : block) c = 'a' + rng() % 26;
+        bernoulli_distribution mutate(level.mutation);
+        for (int i = 0; i < n; i++) s[i] = mutate(rng) ? 'a' + rng() % 26 : block[i % level.period];
+        vector<int> suffixArray = buildSuffixArray(s);
+
+        auto time = [&](auto build, vector<int> &lcp) {
+            auto start = chrono::steady_clock::now();
+            lcp = build(s, suffixArray);
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
+        for (auto &[name, bytewiseBuild, kernelBuild] : builders) {
+            vector<int> expected, lcp;
+            double bytewise = time(bytewiseBuild, expected);
+            double kernel = time(kernelBuild, lcp);
+            double mean = n ? accumulate(expected.begin(), expected.end(), 0.0) / n : 0;
+            cout << left << setw(28) << level.name << setw(12) << fixed << setprecision(1) << mean
+                 << setw(22) << name << setw(14) << setprecision(3) << bytewise << setw(14) << kernel
+                 << setprecision(2) << bytewise / max(kernel, 1e-9) << "x"
+                 << (lcp == expected ? "" : "  MISMATCH") << endl;
+        }
+    }
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    string mode = argc > 1 ? argv[1] : "compare";
+    if (mode == "simd") {
+        benchmarkKernel(argc > 2 ? atoi(argv[2]) : 1 << 24);
+        return 0;
+    }
+    int q = argc > 2 ? max(1, atoi(argv[2])) : 32;
+    int threads = argc > 2 && mode != "sparse" && mode != "compare" ? max(1, atoi(argv[2]))
+                                                                      : max(1, (int)thread::hardware_concurrency());
+
+    InputText input;
+    string word;
+    string_view s;
+    if (argc > 3) {
+        if (!input.open(argv[3])) {
+            cerr << "cannot read " << argv[3] << endl;
+            return 1;
+        }
+        s = input.view();
+    } else {
+        cin >> word;
+        s = word;
+    }
+    vector<int> suffixArray = buildSuffixArray(s);
+
+    if (mode == "compare") {
+        compareBuilders(s, suffixArray, q, threads);
+        return 0;
+    }
+    if (mode == "scaling") {
+        measureScaling(s, suffixArray, threads);
+        return 0;
+    }
+
+    // kasai | phi | sparse [q] | parallel [threads]: print n, SA and LCP in the lcp+suffix.cpp format
+    vector<int> lcpArray;
+    if (mode == "kasai") lcpArray = buildLCPArray(s, suffixArray);
+    else if (mode == "phi") lcpArray = buildLCPArrayPhi(s, suffixArray);
+    else if (mode == "sparse") lcpArray = buildLCPArraySparsePhi(s, suffixArray, q);
+    else if (mode == "parallel") lcpArray = buildLCPArrayParallel(s, suffixArray, threads);
+    else {
+        cerr << "usage: " << argv[0] << " [compare|kasai|phi|sparse] [q] [text-file|-] < input.txt" << endl
+             << "       " << argv[0] << " parallel|scaling [threads] [text-file|-] < input.txt" << endl
+             << "       " << argv[0] << " simd [n]" << endl;
+        return 1;
+    }
+    int n = s.size();
+    cout << n << ' ';
+    for (int i = 0; i < n; ++i) cout << suffixArray[i] << " ";
+    cout << endl;
+    for (int i = 0; i < n; ++i) cout << lcpArray[i] << " ";
+    cout << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,399 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: LCP of Any Two Suffixes via Range Minimum Queries
+ *
+ *    Description:
+ *    buildLCPArray (Kasai) only gives the LCP of suffixes that are adjacent
+ *    in the suffix array. The LCP of any two suffixes is the minimum of the
+ *    LCP array between their ranks, so a range-minimum structure over the
+ *    LCP array answers lcp(i, j) for arbitrary text positions in O(1).
+ *    Two RMQ variants are provided and benchmarked against each other:
+ *      - SparseTableRMQ: O(n log n) space, two lookups per query.
+ *      - BlockRMQ: O(n) space (64-bit block masks + sparse table on block
+ *        minima), at most three lookups per query.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall LCP_RMQ.cpp -o lcp_rmq
+ *
+ *    Execution:
+ *         ./lcp_rmq < input.txt              (text, q, then q pairs i j)
+ *         ./lcp_rmq bench [queries] < input.txt
+ *         ./lcp_rmq query corpus.bin < pairs.txt   (every byte of the file; q, then pairs)
+ *         ./lcp_rmq bench [queries] corpus.bin
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Function to build the LCP array using Kasai's algorithm
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+// --------------------------------------------------------------------
+// Sparse table: O(n log n) space, O(1) query
+// --------------------------------------------------------------------
+/*
+   table[k][i] = min(a[i .. i + 2^k - 1]). A query [l, r] is covered by
+   two overlapping power-of-two windows, so it costs two lookups.
+*/
+struct SparseTableRMQ {
+    vector<vector<int>> table;
+
+    void build(const vector<int> &a) {
+        int n = a.size();
+        table.assign(1, a);
+        for (int k = 1; (1 << k) <= n; k++) {
+            const vector<int> &prev = table[k - 1];
+            vector<int> level(n - (1 << k) + 1);
+            for (int i = 0; i + (1 << k) <= n; i++) level[i] = min(prev[i], prev[i + (1 << (k - 1))]);
+            table.push_back(move(level));
+        }
+    }
+
+    // Minimum of a[l..r], l <= r
+    int query(int l, int r) const {
+        int k = 31 - __builtin_clz(r - l + 1);
+        return min(table[k][l], table[k][r - (1 << k) + 1]);
+    }
+
+    size_t bytes() const {
+        size_t total = 0;
+        for (auto &level : table) total += level.size() * sizeof(int);
+        return total;
+    }
+};
+
+// --------------------------------------------------------------------
+// Block-decomposed RMQ: O(n) space, O(1) query
+// --------------------------------------------------------------------
+/*
+   The array is cut into blocks of 64. Block minima go into a sparse table
+   (n/64 * log n entries). Inside a block, masks[i] has bit j set when
+   position j of the block is on the increasing "minimum stack" ending at
+   i; the minimum of [l, r] within one block is then the lowest set bit of
+   masks[r] at or above l. A query touches at most two in-block lookups
+   and one sparse-table lookup.
+*/
+struct BlockRMQ {
+    static const int B = 64;
+    const vector<int> *a = nullptr;
+    vector<uint64_t> masks;
+    SparseTableRMQ blockMin;
+
+    void build(const vector<int> &values) {
+        a = &values;
+        int n = values.size();
+        masks.assign(n, 0);
+        vector<int> minima((n + B - 1) / B);
+        vector<int> stack;
+        for (int start = 0; start < n; start += B) {
+            int end = min(n, start + B);
+            uint64_t mask = 0;
+            stack.clear();
+            for (int i = start; i < end; i++) {
+                while (!stack.empty() && values[stack.back()] >= values[i]) {
+                    mask ^= 1ULL << (stack.back() - start);
+                    stack.pop_back();
+                }
+                mask |= 1ULL << (i - start);
+                stack.push_back(i);
+                masks[i] = mask;
+            }
+            minima[start / B] = values[stack.front()];
+        }
+        blockMin.build(minima);
+    }
+
+    // Minimum of a[l..r] for l <= r in the same block
+    int inBlock(int l, int r) const {
+        uint64_t m = masks[r] >> (l % B);
+        return (*a)[l + __builtin_ctzll(m)];
+    }
+
+    // Minimum of a[l..r], l <= r
+    int query(int l, int r) const {
+        int bl = l / B, br = r / B;
+        if (bl == br) return inBlock(l, r);
+        int best = min(inBlock(l, bl * B + B - 1), inBlock(br * B, r));
+        if (bl + 1 < br) best = min(best, blockMin.query(bl + 1, br - 1));
+        return best;
+    }
+
+    size_t bytes() const { return masks.size() * sizeof(uint64_t) + blockMin.bytes(); }
+};
+
+// --------------------------------------------------------------------
+// LCP of two arbitrary suffixes, addressed by text position
+// --------------------------------------------------------------------
+/*
+   LCP(suffix i, suffix j) = min(lcp[rank[i] + 1 .. rank[j]]) for
+   rank[i] < rank[j], so one RMQ over the Kasai array answers it.
+*/
+template <class RMQ>
+struct SuffixLCP {
+    int n;
+    vector<int> rank;
+    RMQ rmq;
+
+    SuffixLCP(const vector<int> &suffixArray, const vector<int> &lcpArray) : n(suffixArray.size()), rank(n) {
+        for (int i = 0; i < n; i++) rank[suffixArray[i]] = i;
+        rmq.build(lcpArray);
+    }
+
+    int lcp(int i, int j) const {
+        if (i == j) return n - i;
+        int ri = rank[i], rj = rank[j];
+        if (ri > rj) swap(ri, rj);
+        return rmq.query(ri + 1, rj);
+    }
+};
+
+// Times `queries` random lcp(i, j) calls; returns a checksum so both variants can be compared
+template <class RMQ>
+long long benchmark(const char *name, const vector<int> &suffixArray, const vector<int> &lcpArray, int queries) {
+    int n = suffixArray.size();
+    auto start = chrono::steady_clock::now();
+    SuffixLCP<RMQ> index(suffixArray, lcpArray);
+    double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    mt19937 rng(12345);
+    vector<pair<int, int>> pairs(queries);
+    for (auto &[i, j] : pairs) i = rng() % n, j = rng() % n;
+
+    start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (auto [i, j] : pairs) checksum += index.lcp(i, j);
+    double queryTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << name << ": build " << buildTime * 1000 << " ms, " << index.rmq.bytes() << " bytes, "
+         << (long long)(queries / queryTime) << " queries/s, checksum " << checksum << endl;
+    return checksum;
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    // The text is every byte of the file named after the mode arguments ("-" for stdin);
+    // without one it is the first word of stdin
+    bool bench = argc > 1 && string(argv[1]) == "bench";
+    int textArg = bench ? 3 : 2;
+    InputText input;
+    string word;
+    string_view s;
+    if (argc > textArg) {
+        if (!input.open(argv[textArg])) {
+            cerr << "cannot read " << argv[textArg] << endl;
+            return 1;
+        }
+        s = input.view();
+    } else {
+        cin >> word;
+        s = word;
+    }
+    clock_t z = clock();
+    vector<int> suffixArray = buildSuffixArray(s);
+    vector<int> lcpArray = buildLCPArray(s, suffixArray);
+
+    if (bench) {
+        // ./lcp_rmq bench [queries] [text-file|-]
+        int queries = argc > 2 ? atoi(argv[2]) : 10000000;
+        if (s.empty()) return 0;
+        long long a = benchmark<SparseTableRMQ>("sparse table", suffixArray, lcpArray, queries);
+        long long b = benchmark<BlockRMQ>("block RMQ   ", suffixArray, lcpArray, queries);
+        if (a != b) cout << "MISMATCH between the two RMQ variants" << endl;
+    } else {
+        // q, then q pairs of text positions i j; prints LCP(suffix i, suffix j)
+        SuffixLCP<BlockRMQ> index(suffixArray, lcpArray);
+        int q, i, j;
+        if (cin >> q) {
+            while (q-- && cin >> i >> j) cout << index.lcp(i, j) << '\n';
+        }
+    }
+    cerr << "Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: LZ77 Factorization from SA + LCP (previous/next smaller values)
+ *
+ *    Description:
+ *    The greedy LZ77 parse cuts the text into factors, left to right: at
+ *    position i the factor is the longest prefix of suffix i that also starts
+ *    at some j < i (a copy "length bytes from j", possibly overlapping i), or
+ *    the single byte s[i] when no earlier position starts with it (a
+ *    literal). Among the suffixes that start before i, the one sharing the
+ *    longest prefix with suffix i is adjacent to it in the suffix array once
+ *    every later suffix is ignored, i.e. it is its previous or next smaller
+ *    value (PSV / NSV) in SA. Two stack passes over SA + LCP give both
+ *    candidates and their lcp for every suffix, the longest previous factor
+ *    array, in O(n); the parse then jumps from factor to factor and streams
+ *    each one out as soon as it is known.
+ *
+ *    The number of factors z is a cheap repetitiveness measure: n / z is the
+ *    average factor length, large for logs and versioned data, close to 1
+ *    for random bytes.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall LZ77_Factorization.cpp -o lz77
+ *
+ *    Execution:
+ *         ./lz77 < input.bin                 (every factor)
+ *         ./lz77 <min-length> < input.bin    (only copies of at least min-length bytes)
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Function to build the LCP array using Kasai's algorithm
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// --------------------------------------------------------------------
+// Longest previous factor from PSV / NSV
+// --------------------------------------------------------------------
+/*
+   lpf[i] is the length of the longest prefix of suffix i that also starts
+   at some position before i, and prevOcc[i] is such a position (-1 when
+   lpf[i] = 0). For rank r, PSV(r) is the closest rank above r whose suffix
+   starts earlier in the text and NSV(r) the closest one below; lcp(r, PSV)
+   is the minimum of LCP over (PSV, r], and likewise for NSV.
+
+   One pass per direction with a stack of ranks whose SA values increase
+   toward the top. Next to every rank the stack keeps the minimum LCP
+   between it and the entry above it (the current rank for the top), so
+   popping an entry folds its minimum into the one below and the lcp of
+   the surviving candidate is always at hand: O(1) amortized per rank.
+*/
+void computeLPF(const vector<int> &suffixArray, const vector<int> &lcp, vector<int> &lpf, vector<int> &prevOcc) {
+    int n = suffixArray.size();
+    lpf.assign(n, 0);
+    prevOcc.assign(n, -1);
+    vector<pair<int, int>> stack;   // (rank, min LCP up to the next entry)
+
+    auto step = [&](int r, int lcpToPrevious) {
+        if (!stack.empty()) stack.back().second = min(stack.back().second, lcpToPrevious);
+        while (!stack.empty() && suffixArray[stack.back().first] > suffixArray[r]) {
+            int gap = stack.back().second;
+            stack.pop_back();
+            if (!stack.empty()) stack.back().second = min(stack.back().second, gap);
+        }
+        if (!stack.empty()) {
+            int i = suffixArray[r], length = stack.back().second;
+            if (length > lpf[i]) {
+                lpf[i] = length;
+                prevOcc[i] = suffixArray[stack.back().first];
+            }
+        }
+        stack.push_back({r, INT_MAX});
+    };
+
+    // PSV: lcp[r] joins ranks r - 1 and r
+    for (int r = 0; r < n; ++r) step(r, lcp[r]);
+    // NSV: lcp[r + 1] joins ranks r and r + 1
+    stack.clear();
+    for (int r = n - 1; r >= 0; --r) step(r, r + 1 < n ? lcp[r + 1] : 0);
+}
+
+// --------------------------------------------------------------------
+// Greedy parse
+// --------------------------------------------------------------------
+struct Factor {
+    int position, length;
+    int source;     // earlier start of the copy, or -1 for a literal (length 1)
+};
+
+// Calls emit(factor) for every factor, left to right; returns the number of factors
+template <class Emit>
+long long factorize(int n, const vector<int> &lpf, const vector<int> &prevOcc, Emit emit) {
+    long long factors = 0;
+    for (int i = 0; i < n; ++factors) {
+        Factor f = lpf[i] > 0 ? Factor{i, lpf[i], prevOcc[i]} : Factor{i, 1, -1};
+        emit(f);
+        i += f.length;
+    }
+    return factors;
+}
+
+/*
+   Output, one line per factor (with a min-length, only copies that long):
+       <position> <source> <length>     copy of length bytes from source
+       <position> L <byte value>        literal
+   then the totals.
+*/
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    int minLength = argc > 1 ? atoi(argv[1]) : 0;
+    InputText input;
+    if (!input.open("-")) {
+        cerr << "cannot read stdin" << endl;
+        return 1;
+    }
+    string_view s = input.view();
+    if (s.size() >= (size_t)INT_MAX) {
+        cerr << "text too long for 32-bit indices" << endl;
+        return 1;
+    }
+    int n = s.size();
+
+    clock_t z = clock();
+    vector<int> lpf, prevOcc;
+    {
+        vector<int> suffixArray = buildSuffixArray(s);
+        vector<int> lcp = buildLCPArray(s, suffixArray);
+        computeLPF(suffixArray, lcp, lpf, prevOcc);
+    }
+    double buildTime = (double)(clock() - z) / CLOCKS_PER_SEC;
+
+    long long literals = 0;
+    Factor longest = {0, 0, -1};
+    long long factors = factorize(n, lpf, prevOcc, [&](const Factor &f) {
+        if (f.source == -1) {
+            literals++;
+            if (minLength == 0) cout << f.position << " L " << (int)(unsigned char)s[f.position] << '\n';
+            return;
+        }
+        if (f.length > longest.length) longest = f;
+        if (f.length >= minLength) cout << f.position << ' ' << f.source << ' ' << f.length << '\n';
+    });
+
+    cout << "Factors : " << factors << ", Literals : " << literals << ", Longest : " << longest.length;
+    if (longest.length > 0) cout << " (at " << longest.position << " from " << longest.source << ")";
+    cout << ", Length / Factors : " << (factors ? (double)n / factors : 0) << endl;
+    cerr << "Length : " << n << ", Build Time : " << buildTime
+         << ", Total Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,325 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Parallel Suffix Array (radix prefix doubling)
+ *
+ *    Description:
+ *    Multi-threaded version of the counting-sort cyclic-shift builder in
+ *    suffix2.cpp. Every round of prefix doubling is split across a fixed
+ *    thread pool:
+ *      - shifting the suffix array by 2^k is a plain parallel map,
+ *      - the stable counting sort by class becomes an LSD radix sort whose
+ *        passes use one histogram per thread, a parallel prefix sum over the
+ *        (digit, thread) table and a parallel stable scatter,
+ *      - class reassignment marks boundaries between different (class, class)
+ *        pairs and turns them into class ids with a parallel prefix sum.
+ *    Rounds stop as soon as every suffix has its own class, so the result is
+ *    the same array suffix2.cpp prints, sentinel position included.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall -pthread Parallel_Suffix_Array.cpp -o parallel_sa
+ *
+ *    Execution:
+ *         ./parallel_sa [threads] < input.txt              (first word of stdin)
+ *         ./parallel_sa <threads> corpus.bin|-           (every byte of the file)
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// --------------------------------------------------------------------
+// Thread pool: the caller acts as worker 0, the pool owns workers 1..T-1
+// --------------------------------------------------------------------
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads) : numThreads(max(1, numThreads)) {
+        for (int t = 1; t < this->numThreads; t++) {
+            workers.emplace_back([this, t] { workerLoop(t); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+            generation++;
+        }
+        wake.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    int size() const { return numThreads; }
+
+    // Runs task(t) for every t in [0, size()) and waits for all of them
+    void run(const function<void(int)> &task) {
+        {
+            lock_guard<mutex> lock(mtx);
+            current = &task;
+            pending = numThreads - 1;
+            generation++;
+        }
+        wake.notify_all();
+        task(0);
+        unique_lock<mutex> lock(mtx);
+        finished.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+private:
+    void workerLoop(int t) {
+        long long seen = 0;
+        while (true) {
+            const function<void(int)> *task;
+            {
+                unique_lock<mutex> lock(mtx);
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) return;
+                task = current;
+            }
+            (*task)(t);
+            {
+                lock_guard<mutex> lock(mtx);
+                if (--pending == 0) finished.notify_one();
+            }
+        }
+    }
+
+    int numThreads;
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable wake, finished;
+    const function<void(int)> *current = nullptr;
+    long long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+// Half-open slice [lo, hi) of [0, n) handled by thread t out of T
+pair<int, int> chunkOf(int n, int T, int t) {
+    long long lo = (long long)n * t / T, hi = (long long)n * (t + 1) / T;
+    return {(int)lo, (int)hi};
+}
+
+// --------------------------------------------------------------------
+// Parallel prefix sum, in place; returns the total
+// --------------------------------------------------------------------
+/*
+   Two passes over T contiguous blocks: every thread sums its block, the T
+   block totals are scanned (T is tiny), then every thread rewrites its
+   block starting from its block offset.
+*/
+int parallelPrefixSum(ThreadPool &pool, vector<int> &a, bool inclusive) {
+    int n = a.size(), T = pool.size();
+    vector<int> blockSum(T + 1, 0);
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        int sum = 0;
+        for (int i = lo; i < hi; i++) sum += a[i];
+        blockSum[t + 1] = sum;
+    });
+    for (int t = 0; t < T; t++) blockSum[t + 1] += blockSum[t];
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        int sum = blockSum[t];
+        for (int i = lo; i < hi; i++) {
+            int x = a[i];
+            a[i] = inclusive ? sum + x : sum;
+            sum += x;
+        }
+    });
+    return blockSum[T];
+}
+
+// --------------------------------------------------------------------
+// Class reassignment: newClasses[SA[i]] = number of boundaries in SA[1..i]
+// --------------------------------------------------------------------
+template <class Boundary>
+int assignClasses(ThreadPool &pool, const vector<int> &suffixArray, Boundary boundary,
+                  vector<int> &newClasses, vector<int> &scratch) {
+    int n = suffixArray.size(), T = pool.size();
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        for (int i = lo; i < hi; i++) scratch[i] = i > 0 && boundary(i);
+    });
+    int numClasses = parallelPrefixSum(pool, scratch, true) + 1;
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        for (int i = lo; i < hi; i++) newClasses[suffixArray[i]] = scratch[i];
+    });
+    return numClasses;
+}
+
+// --------------------------------------------------------------------
+// One stable counting-sort pass: out = in scattered by digit(x) in [0, radix)
+// --------------------------------------------------------------------
+/*
+   hist is a (digit, thread) table laid out digit-major, so its exclusive
+   prefix sum is exactly the first output slot of every (digit, thread)
+   pair: all smaller digits come first, and within one digit the threads
+   keep their input order, which makes the pass stable.
+*/
+template <class Digit>
+void countingSortPass(ThreadPool &pool, const vector<int> &in, vector<int> &out,
+                      int radix, Digit digit, vector<int> &hist) {
+    int n = in.size(), T = pool.size();
+    hist.assign((size_t)radix * T, 0);
+    // Count and scatter through thread-local copies so threads never share cache lines
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        vector<int> local(radix, 0);
+        for (int i = lo; i < hi; i++) local[digit(in[i])]++;
+        for (int d = 0; d < radix; d++) hist[(size_t)d * T + t] = local[d];
+    });
+    parallelPrefixSum(pool, hist, false);
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        vector<int> local(radix);
+        for (int d = 0; d < radix; d++) local[d] = hist[(size_t)d * T + t];
+        for (int i = lo; i < hi; i++) {
+            int x = in[i];
+            out[local[digit(x)]++] = x;
+        }
+    });
+}
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+const int RADIX_BITS = 11;
+
+// Function to build the suffix array of s + sentinel with T threads; the sentinel
+// at position s.size() is virtual, so s may hold any byte
+vector<int> buildSuffixArrayParallel(string_view s, ThreadPool &pool) {
+    int n = s.size() + 1, T = pool.size();
+    vector<int> suffixArray(n), classes(n), tempSuffixArray(n), tempClasses(n), hist;
+
+    // Initial sorting by the first character; the last character is the sentinel
+    auto firstKey = [&](int i) { return i == n - 1 ? 0 : (unsigned char)s[i] + 1; };
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        for (int i = lo; i < hi; i++) tempSuffixArray[i] = i;
+    });
+    countingSortPass(pool, tempSuffixArray, suffixArray, 257, firstKey, hist);
+
+    // Initial classes: a boundary wherever the first character changes
+    int numClasses = assignClasses(pool, suffixArray, [&](int i) {
+        return firstKey(suffixArray[i]) != firstKey(suffixArray[i - 1]);
+    }, classes, tempSuffixArray);
+
+    // Iteratively sort by 2^k characters
+    for (int k = 0; (1 << k) < n && numClasses < n; k++) {
+        int shift = 1 << k;
+
+        // Sorted by the second half already: shift every suffix left by 2^k
+        pool.run([&](int t) {
+            auto [lo, hi] = chunkOf(n, T, t);
+            for (int i = lo; i < hi; i++) {
+                int p = suffixArray[i] - shift;
+                tempSuffixArray[i] = p < 0 ? p + n : p;
+            }
+        });
+
+        // Stable LSD radix sort by the class of the first half
+        int bits = 1;
+        while ((1LL << bits) < numClasses) bits++;
+        int passes = (bits + RADIX_BITS - 1) / RADIX_BITS;
+        vector<int> *from = &tempSuffixArray, *to = &suffixArray;
+        for (int pass = 0; pass < passes; pass++) {
+            int low = pass * RADIX_BITS;
+            int radix = 1 << min(RADIX_BITS, bits - low);
+            countingSortPass(pool, *from, *to, radix,
+                             [&](int x) { return (classes[x] >> low) & (radix - 1); }, hist);
+            swap(from, to);
+        }
+        if (from != &suffixArray) suffixArray.swap(*from);
+
+        // New classes: a boundary wherever the (first half, second half) pair changes
+        numClasses = assignClasses(pool, suffixArray, [&](int i) {
+            int a = suffixArray[i], b = suffixArray[i - 1];
+            int a2 = a + shift < n ? a + shift : a + shift - n;
+            int b2 = b + shift < n ? b + shift : b + shift - n;
+            return classes[a] != classes[b] || classes[a2] != classes[b2];
+        }, tempClasses, tempSuffixArray);
+        classes.swap(tempClasses);
+    }
+
+    return suffixArray;
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    int threads = argc > 1 ? atoi(argv[1]) : (int)thread::hardware_concurrency();
+    ThreadPool pool(threads);
+
+    InputText input;
+    string word;
+    string_view s;
+    if (argc > 2) {
+        if (!input.open(argv[2])) {
+            cerr << "cannot read " << argv[2] << endl;
+            return 1;
+        }
+        s = input.view();
+    } else {
+        cin >> word;
+        s = word;
+    }
+
+    clock_t z = clock();
+    auto start = chrono::steady_clock::now();
+    vector<int> suffixArray = buildSuffixArrayParallel(s, pool);
+    double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (int i = 0; i < (int)suffixArray.size(); i++) {
+        cout << suffixArray[i] << " ";
+    }
+    cout << endl;
+
+    cerr << "Threads : " << pool.size() << ", Wall Time : " << wall
+         << ", CPU Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
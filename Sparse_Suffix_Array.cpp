@@ -0,0 +1,391 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Sparse Suffix Array (word / line boundaries)
+ *
+ *    Description:
+ *    For log search only the suffixes that start at a token or line
+ *    boundary matter. This builds SA and LCP over just those m suffixes:
+ *      - boundary mode (a delimiter predicate): the text is cut into
+ *        delimiter-terminated tokens, the tokens are ranked, and SA-IS runs
+ *        on the m token ranks; LCP comes from a sparse Kasai pass. Apart
+ *        from the text itself, every array is proportional to m, not n,
+ *        and so is the work after ranking.
+ *      - every-q mode: the same reduction with tokens of q bytes, so the
+ *        time and memory after ranking shrink with the sampling rate too.
+ *      - list mode (arbitrary start positions): the full SA and LCP array,
+ *        filtered down to the sampled suffixes; O(n) time and memory.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Sparse_Suffix_Array.cpp -o sparse_sa
+ *
+ *    Execution:
+ *         ./sparse_sa words|lines|every <q> [patterns...] < input.txt
+ */
+
+#include <bits/stdc++.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Length of the common prefix of a[0..limit) and b[0..limit)
+//
+// Short matches (the common case) are compared byte by byte, so the CPU can
+// keep speculating past them; from the 9th byte on, 32 (AVX2) or 16 (SSE2)
+// bytes are compared per step and the first mismatch is the lowest zero bit
+// of the equality mask (ctz). Without SIMD, 8 bytes are compared per step as
+// 64-bit words. Build with -mavx2 or -march=native for the AVX2 path.
+inline int mismatchLength(const char *a, const char *b, int limit) {
+    int k = 0, head = min<int>(limit, 8);
+    while (k < head && a[k] == b[k]) ++k;
+    if (k < head || k == limit) return k;
+#if defined(__AVX2__)
+    for (; k + 32 <= limit; k += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + k));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + k));
+        uint32_t equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFFFFFu) return k + __builtin_ctz(~equal);
+    }
+#elif defined(__SSE2__)
+    for (; k + 16 <= limit; k += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + k));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + k));
+        uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFu) return k + __builtin_ctz(~equal & 0xFFFFu);
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; k + 8 <= limit; k += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + k, 8);
+        memcpy(&y, b + k, 8);
+        if (x != y) return k + __builtin_ctzll(x ^ y) / 8;
+    }
+#endif
+    while (k < limit && a[k] == b[k]) ++k;
+    return k;
+}
+
+// --------------------------------------------------------------------
+// Sparse suffix array: only suffixes that start at chosen positions
+// --------------------------------------------------------------------
+struct SparseSuffixArray {
+    vector<int> suffixArray; // sampled text positions, in suffix order
+    vector<int> lcp;         // lcp[r] = LCP(suffixArray[r - 1], suffixArray[r]) in bytes, lcp[0] = 0
+};
+
+// Function to build the sparse LCP array with Kasai's algorithm over token starts
+/*
+   tokenOrder is the sparse suffix array as token numbers (SA entry r is
+   the suffix at starts[tokenOrder[r]]), so its inverse rank is indexed by
+   token number and takes m integers, not n. starts are visited in text
+   order. When suffix starts[k] shares h >= g
+   bytes (g = starts[k + 1] - starts[k]) with its SA predecessor p, the
+   match covers the whole token, so p + g is a sampled position too and
+   LCP(starts[k + 1], its predecessor) >= h - g. The counter is therefore
+   carried over with h - g instead of h - 1; the extra decrements add up
+   to at most n over the whole pass, so it stays O(n).
+*/
+vector<int> buildSparseLCPArray(const string &s, const vector<int> &starts, const vector<int> &tokenOrder) {
+    int m = starts.size(), n = s.size();
+    vector<int> rank(m), lcp(m, 0);
+    for (int r = 0; r < m; ++r) rank[tokenOrder[r]] = r;
+
+    int h = 0;
+    for (int k = 0; k < m; ++k) {
+        int i = starts[k], r = rank[k];
+        if (r > 0) {
+            int j = starts[tokenOrder[r - 1]];
+            h += mismatchLength(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+            lcp[r] = h;
+        } else {
+            h = 0;
+        }
+        int gap = k + 1 < m ? starts[k + 1] - i : 0;
+        h = max(0, h - gap);
+    }
+    return lcp;
+}
+
+// Function to build the sparse suffix array of the suffixes at token starts
+/*
+   starts (increasing, starting at 0) cut the text into tokens, and no
+   token may be a proper prefix of another unless it is the last one.
+   Comparing two sampled suffixes token by token then gives the same order
+   as comparing them byte by byte. The tokens are ranked once (sort +
+   dedupe), the text becomes a sequence of m token ranks, and SA-IS on that
+   sequence is exactly the sparse suffix array. Memory and time after the
+   token sort are O(m), not O(n).
+*/
+SparseSuffixArray buildSparseSuffixArrayOverTokens(const string &s, const vector<int> &starts) {
+    int n = s.size(), m = starts.size();
+
+    // Rank the distinct tokens
+    vector<string_view> tokens(m);
+    for (int k = 0; k < m; ++k) {
+        int end = k + 1 < m ? starts[k + 1] : n;
+        tokens[k] = string_view(s.data() + starts[k], end - starts[k]);
+    }
+    vector<int> order(m);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b) { return tokens[a] < tokens[b]; });
+    vector<int> tokenRank(m);
+    int names = 0;
+    for (int k = 0; k < m; ++k) {
+        if (k > 0 && tokens[order[k]] != tokens[order[k - 1]]) ++names;
+        tokenRank[order[k]] = names;
+    }
+
+    SparseSuffixArray result;
+    result.suffixArray = inducedSort(tokenRank, names);
+    result.lcp = buildSparseLCPArray(s, starts, result.suffixArray);
+    for (int &p : result.suffixArray) p = starts[p];
+    return result;
+}
+
+// Function to build the sparse suffix array over delimiter-terminated tokens
+/*
+   A suffix starts at 0 and right after every delimiter byte, so every
+   token ends with exactly one delimiter (the last one may end with the
+   text instead) and none is a proper prefix of another.
+*/
+template <class IsDelimiter>
+SparseSuffixArray buildSparseSuffixArray(const string &s, IsDelimiter isDelimiter) {
+    int n = s.size();
+    vector<int> starts;
+    for (int i = 0; i < n; ++i) {
+        if (i == 0 || isDelimiter((unsigned char)s[i - 1])) starts.push_back(i);
+    }
+    return buildSparseSuffixArrayOverTokens(s, starts);
+}
+
+// Function to build the sparse suffix array of every q-th suffix
+/*
+   Tokens of exactly q bytes: only the last can be shorter, and it ends the
+   text, so the token reduction applies. If suffix p shares h >= q bytes
+   with its predecessor, p + q and the predecessor + q are sampled too, so
+   the gap bound of buildSparseLCPArray holds as well. Ranking the tokens
+   compares at most q bytes per comparison, O(n log m) in the worst case
+   (all tokens equal); everything after it is O(m).
+*/
+SparseSuffixArray buildSparseSuffixArrayEvery(const string &s, int q) {
+    vector<int> starts;
+    for (int i = 0; i < (int)s.size(); i += q) starts.push_back(i);
+    return buildSparseSuffixArrayOverTokens(s, starts);
+}
+
+// Function to build the sparse suffix array over an arbitrary list of start positions
+/*
+   Irregular samples have no token reduction, and sorting them by direct
+   suffix comparison costs O(m log m * n) on repetitive text. Instead the
+   full SA is built with SA-IS and filtered; the LCP of two consecutive
+   sampled suffixes is the minimum of the full LCP array between them, kept
+   as a running minimum during the filter. O(n) time and memory whatever
+   the sample.
+*/
+SparseSuffixArray buildSparseSuffixArray(const string &s, const vector<int> &starts) {
+    int n = s.size();
+    vector<char> sampled(n, 0);
+    for (int p : starts) sampled[p] = 1;
+
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) c &= 0xFF;
+    vector<int> fullSA = inducedSort(symbols, 255);
+    vector<int>().swap(symbols);
+    vector<int> rank(n), fullLCP(n, 0);
+    for (int r = 0; r < n; ++r) rank[fullSA[r]] = r;
+    for (int i = 0, h = 0; i < n; ++i) {
+        if (rank[i] == 0) { h = 0; continue; }
+        int j = fullSA[rank[i] - 1];
+        h += mismatchLength(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
+        fullLCP[rank[i]] = h;
+        if (h > 0) --h;
+    }
+
+    SparseSuffixArray result;
+    int shared = 0;
+    for (int r = 0; r < n; ++r) {
+        shared = min(shared, fullLCP[r]);
+        if (!sampled[fullSA[r]]) continue;
+        result.suffixArray.push_back(fullSA[r]);
+        result.lcp.push_back(result.suffixArray.size() == 1 ? 0 : shared);
+        shared = INT_MAX;
+    }
+    return result;
+}
+
+// Sampled positions whose suffix starts with p, in increasing order
+vector<int> locate(const string &s, const SparseSuffixArray &index, const string &p) {
+    const vector<int> &sa = index.suffixArray;
+    auto cmp = [&](int suffix) {
+        int len = min(p.size(), s.size() - suffix);
+        int c = memcmp(s.data() + suffix, p.data(), len);
+        if (c != 0) return c;
+        return len < (int)p.size() ? -1 : 0;
+    };
+    int lo = partition_point(sa.begin(), sa.end(), [&](int x) { return cmp(x) < 0; }) - sa.begin();
+    int hi = partition_point(sa.begin() + lo, sa.end(), [&](int x) { return cmp(x) == 0; }) - sa.begin();
+    vector<int> positions(sa.begin() + lo, sa.begin() + hi);
+    sort(positions.begin(), positions.end());
+    return positions;
+}
+
+/*
+   ./sparse_sa words|lines|every <q> [patterns...] < input.txt
+
+   The whole input, whitespace included, is the text.
+     words      suffixes at 0 and after every space, tab or newline
+     lines      suffixes at 0 and after every newline
+     every q    suffixes at every q-th position (q-byte tokens)
+   Prints m, the sparse SA and its LCP array in the lcp+suffix.cpp format,
+   then for every pattern the sampled positions where it occurs.
+*/
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    string mode = argc > 1 ? argv[1] : "";
+    int firstPattern = mode == "every" ? 3 : 2;
+    if ((mode != "words" && mode != "lines" && mode != "every") || argc < firstPattern) {
+        cerr << "usage: " << argv[0] << " words|lines|every <q> [patterns...] < input.txt" << endl;
+        return 1;
+    }
+    string s((istreambuf_iterator<char>(cin)), istreambuf_iterator<char>());
+    int n = s.size();
+
+    clock_t z = clock();
+    SparseSuffixArray index;
+    if (mode == "words") {
+        index = buildSparseSuffixArray(s, [](unsigned char c) { return c == ' ' || c == '\t' || c == '\n'; });
+    } else if (mode == "lines") {
+        index = buildSparseSuffixArray(s, [](unsigned char c) { return c == '\n'; });
+    } else {
+        index = buildSparseSuffixArrayEvery(s, max(1, atoi(argv[2])));
+    }
+    double seconds = (double)(clock() - z) / CLOCKS_PER_SEC;
+
+    int m = index.suffixArray.size();
+    cout << m << ' ';
+    for (int r = 0; r < m; ++r) cout << index.suffixArray[r] << " ";
+    cout << endl;
+    for (int r = 0; r < m; ++r) cout << index.lcp[r] << " ";
+    cout << endl;
+    for (int a = firstPattern; a < argc; a++) {
+        vector<int> positions = locate(s, index, argv[a]);
+        cout << positions.size() << ':';
+        for (int p : positions) cout << ' ' << p;
+        cout << endl;
+    }
+
+    cerr << "Sampled " << m << " of " << n << " suffixes (" << (n ? 100.0 * m / n : 0)
+         << "%), Run Time : " << seconds << endl;
+    return 0;
+}
\ No newline at end of file
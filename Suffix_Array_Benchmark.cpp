@@ -0,0 +1,651 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Suffix Array Construction Benchmark
+ *
+ *    Description:
+ *    Runs every suffix array builder in the repo on the same generated
+ *    corpora and reports throughput, peak memory and the number of rounds:
+ *      - SA-IS (the default builder of suffix1.cpp, lcp+suffix.cpp and
+ *        Suffix_Array_and_LCP_Array.cpp),
+ *      - std::sort prefix doubling (their -DSA_DOUBLING builder),
+ *      - counting-sort cyclic doubling (suffix2.cpp),
+ *      - parallel radix doubling (Parallel_Suffix_Array.cpp).
+ *    The corpora range from uniform random text, where every builder is
+ *    fast, to single-character runs and Fibonacci words, which are the
+ *    worst cases for prefix doubling. Each run happens in its own process,
+ *    and all suffix arrays are checked against SA-IS.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall -pthread Suffix_Array_Benchmark.cpp -o sa_bench
+ *
+ *    Execution:
+ *         ./sa_bench [-j threads] [-b seconds] [-c corpus,...] [sizes...]
+ *         ./sa_bench -c dna,fibonacci 1M 64M
+ */
+
+#include <bits/stdc++.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper, int &levels) {
+    levels++;
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names, levels);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n); rounds = recursion levels
+vector<int> buildSuffixArraySAIS(const string &s, int &rounds) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    rounds = 0;
+    return inducedSort(symbols, 255, rounds);
+}
+
+// --------------------------------------------------------------------
+// Builders under test; each returns the SA of s (no sentinel entry) and
+// reports its number of rounds
+// --------------------------------------------------------------------
+
+// suffix1.cpp / lcp+suffix.cpp / Suffix_Array_and_LCP_Array.cpp -DSA_DOUBLING:
+// std::sort on (rank, rank + k) pairs, O(n log^2 n)
+vector<int> buildSuffixArraySortDoubling(const string &s, int &rounds) {
+    int n = s.size();
+    vector<int> suffixArray(n), rank(n), tempRank(n);
+    for (int i = 0; i < n; ++i) {
+        suffixArray[i] = i;
+        rank[i] = (unsigned char)s[i];
+    }
+    rounds = 0;
+    // k is 64-bit so that doubling past 2^30 cannot overflow; stop once every rank is distinct
+    for (long long k = 1; k < n; k *= 2) {
+        auto compare = [&](int a, int b) {
+            if (rank[a] != rank[b]) return rank[a] < rank[b];
+            int rankA = (a + k < n) ? rank[a + k] : -1;
+            int rankB = (b + k < n) ? rank[b + k] : -1;
+            return rankA < rankB;
+        };
+        sort(suffixArray.begin(), suffixArray.end(), compare);
+        tempRank[suffixArray[0]] = 0;
+        for (int i = 1; i < n; ++i) {
+            tempRank[suffixArray[i]] = tempRank[suffixArray[i - 1]] + compare(suffixArray[i - 1], suffixArray[i]);
+        }
+        rank.swap(tempRank);
+        rounds++;
+        if (rank[suffixArray[n - 1]] == n - 1) break;
+    }
+    return suffixArray;
+}
+
+// suffix2.cpp: counting sort of cyclic shifts, O(n log n). The sentinel is
+// the virtual position n with key 0, so every byte value is allowed.
+vector<int> buildSuffixArrayCyclic(const string &s, int &rounds) {
+    int n = s.size() + 1;
+    vector<int> suffixArray(n), classes(n), cnt(max(257, n), 0);
+    auto firstKey = [&](int i) { return i == n - 1 ? 0 : (unsigned char)s[i] + 1; };
+
+    for (int i = 0; i < n; i++) cnt[firstKey(i)]++;
+    for (int i = 1; i < 257; i++) cnt[i] += cnt[i - 1];
+    for (int i = n - 1; i >= 0; i--) suffixArray[--cnt[firstKey(i)]] = i;
+
+    classes[suffixArray[0]] = 0;
+    int numClasses = 1;
+    for (int i = 1; i < n; i++) {
+        if (firstKey(suffixArray[i]) != firstKey(suffixArray[i - 1])) numClasses++;
+        classes[suffixArray[i]] = numClasses - 1;
+    }
+
+    vector<int> tempSuffixArray(n), tempClasses(n);
+    rounds = 0;
+    // shift is 64-bit: past n = 2^30 an int 1 << k overflows. Stop once every suffix has its own class
+    for (long long shift = 1; shift < n && numClasses < n; shift *= 2) {
+        for (int i = 0; i < n; i++) {
+            long long p = suffixArray[i] - shift;
+            tempSuffixArray[i] = p < 0 ? p + n : p;
+        }
+        fill(cnt.begin(), cnt.begin() + numClasses, 0);
+        for (int i = 0; i < n; i++) cnt[classes[tempSuffixArray[i]]]++;
+        for (int i = 1; i < numClasses; i++) cnt[i] += cnt[i - 1];
+        for (int i = n - 1; i >= 0; i--) suffixArray[--cnt[classes[tempSuffixArray[i]]]] = tempSuffixArray[i];
+
+        tempClasses[suffixArray[0]] = 0;
+        numClasses = 1;
+        for (int i = 1; i < n; i++) {
+            pair<int, int> curr = {classes[suffixArray[i]], classes[(suffixArray[i] + shift) % n]};
+            pair<int, int> prev = {classes[suffixArray[i - 1]], classes[(suffixArray[i - 1] + shift) % n]};
+            if (curr != prev) numClasses++;
+            tempClasses[suffixArray[i]] = numClasses - 1;
+        }
+        classes.swap(tempClasses);
+        rounds++;
+    }
+    suffixArray.erase(suffixArray.begin());
+    return suffixArray;
+}
+
+// --------------------------------------------------------------------
+// Thread pool: the caller acts as worker 0, the pool owns workers 1..T-1
+// --------------------------------------------------------------------
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads) : numThreads(max(1, numThreads)) {
+        for (int t = 1; t < this->numThreads; t++) {
+            workers.emplace_back([this, t] { workerLoop(t); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+            generation++;
+        }
+        wake.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    int size() const { return numThreads; }
+
+    // Runs task(t) for every t in [0, size()) and waits for all of them
+    void run(const function<void(int)> &task) {
+        {
+            lock_guard<mutex> lock(mtx);
+            current = &task;
+            pending = numThreads - 1;
+            generation++;
+        }
+        wake.notify_all();
+        task(0);
+        unique_lock<mutex> lock(mtx);
+        finished.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+private:
+    void workerLoop(int t) {
+        long long seen = 0;
+        while (true) {
+            const function<void(int)> *task;
+            {
+                unique_lock<mutex> lock(mtx);
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) return;
+                task = current;
+            }
+            (*task)(t);
+            {
+                lock_guard<mutex> lock(mtx);
+                if (--pending == 0) finished.notify_one();
+            }
+        }
+    }
+
+    int numThreads;
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable wake, finished;
+    const function<void(int)> *current = nullptr;
+    long long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+// Half-open slice [lo, hi) of [0, n) handled by thread t out of T
+pair<int, int> chunkOf(int n, int T, int t) {
+    long long lo = (long long)n * t / T, hi = (long long)n * (t + 1) / T;
+    return {(int)lo, (int)hi};
+}
+
+// --------------------------------------------------------------------
+// Parallel prefix sum, in place; returns the total
+// --------------------------------------------------------------------
+/*
+   Two passes over T contiguous blocks: every thread sums its block, the T
+   block totals are scanned (T is tiny), then every thread rewrites its
+   block starting from its block offset.
+*/
+int parallelPrefixSum(ThreadPool &pool, vector<int> &a, bool inclusive) {
+    int n = a.size(), T = pool.size();
+    vector<int> blockSum(T + 1, 0);
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        int sum = 0;
+        for (int i = lo; i < hi; i++) sum += a[i];
+        blockSum[t + 1] = sum;
+    });
+    for (int t = 0; t < T; t++) blockSum[t + 1] += blockSum[t];
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        int sum = blockSum[t];
+        for (int i = lo; i < hi; i++) {
+            int x = a[i];
+            a[i] = inclusive ? sum + x : sum;
+            sum += x;
+        }
+    });
+    return blockSum[T];
+}
+
+// --------------------------------------------------------------------
+// Class reassignment: newClasses[SA[i]] = number of boundaries in SA[1..i]
+// --------------------------------------------------------------------
+template <class Boundary>
+int assignClasses(ThreadPool &pool, const vector<int> &suffixArray, Boundary boundary,
+                  vector<int> &newClasses, vector<int> &scratch) {
+    int n = suffixArray.size(), T = pool.size();
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        for (int i = lo; i < hi; i++) scratch[i] = i > 0 && boundary(i);
+    });
+    int numClasses = parallelPrefixSum(pool, scratch, true) + 1;
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        for (int i = lo; i < hi; i++) newClasses[suffixArray[i]] = scratch[i];
+    });
+    return numClasses;
+}
+
+// --------------------------------------------------------------------
+// One stable counting-sort pass: out = in scattered by digit(x) in [0, radix)
+// --------------------------------------------------------------------
+/*
+   hist is a (digit, thread) table laid out digit-major, so its exclusive
+   prefix sum is exactly the first output slot of every (digit, thread)
+   pair: all smaller digits come first, and within one digit the threads
+   keep their input order, which makes the pass stable.
+*/
+template <class Digit>
+void countingSortPass(ThreadPool &pool, const vector<int> &in, vector<int> &out,
+                      int radix, Digit digit, vector<int> &hist) {
+    int n = in.size(), T = pool.size();
+    hist.assign((size_t)radix * T, 0);
+    // Count and scatter through thread-local copies so threads never share cache lines
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        vector<int> local(radix, 0);
+        for (int i = lo; i < hi; i++) local[digit(in[i])]++;
+        for (int d = 0; d < radix; d++) hist[(size_t)d * T + t] = local[d];
+    });
+    parallelPrefixSum(pool, hist, false);
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        vector<int> local(radix);
+        for (int d = 0; d < radix; d++) local[d] = hist[(size_t)d * T + t];
+        for (int i = lo; i < hi; i++) {
+            int x = in[i];
+            out[local[digit(x)]++] = x;
+        }
+    });
+}
+
+const int RADIX_BITS = 11;
+
+// Parallel_Suffix_Array.cpp: LSD radix doubling on a thread pool, stops
+// once every suffix has its own class
+vector<int> buildSuffixArrayParallel(const string &s, ThreadPool &pool, int &rounds) {
+    int n = s.size() + 1, T = pool.size();
+    vector<int> suffixArray(n), classes(n), tempSuffixArray(n), tempClasses(n), hist;
+
+    auto firstKey = [&](int i) { return i == n - 1 ? 0 : (unsigned char)s[i] + 1; };
+    pool.run([&](int t) {
+        auto [lo, hi] = chunkOf(n, T, t);
+        for (int i = lo; i < hi; i++) tempSuffixArray[i] = i;
+    });
+    countingSortPass(pool, tempSuffixArray, suffixArray, 257, firstKey, hist);
+    int numClasses = assignClasses(pool, suffixArray, [&](int i) {
+        return firstKey(suffixArray[i]) != firstKey(suffixArray[i - 1]);
+    }, classes, tempSuffixArray);
+
+    rounds = 0;
+    for (long long shift = 1; shift < n && numClasses < n; shift *= 2) {
+        pool.run([&](int t) {
+            auto [lo, hi] = chunkOf(n, T, t);
+            for (int i = lo; i < hi; i++) {
+                long long p = suffixArray[i] - shift;
+                tempSuffixArray[i] = p < 0 ? p + n : p;
+            }
+        });
+
+        int bits = 1;
+        while ((1LL << bits) < numClasses) bits++;
+        int passes = (bits + RADIX_BITS - 1) / RADIX_BITS;
+        vector<int> *from = &tempSuffixArray, *to = &suffixArray;
+        for (int pass = 0; pass < passes; pass++) {
+            int low = pass * RADIX_BITS;
+            int radix = 1 << min(RADIX_BITS, bits - low);
+            countingSortPass(pool, *from, *to, radix,
+                             [&](int x) { return (classes[x] >> low) & (radix - 1); }, hist);
+            swap(from, to);
+        }
+        if (from != &suffixArray) suffixArray.swap(*from);
+
+        numClasses = assignClasses(pool, suffixArray, [&](int i) {
+            int a = suffixArray[i], b = suffixArray[i - 1];
+            int a2 = a + shift < n ? a + shift : a + shift - n;
+            int b2 = b + shift < n ? b + shift : b + shift - n;
+            return classes[a] != classes[b] || classes[a2] != classes[b2];
+        }, tempClasses, tempSuffixArray);
+        classes.swap(tempClasses);
+        rounds++;
+    }
+    suffixArray.erase(suffixArray.begin());
+    return suffixArray;
+}
+
+// --------------------------------------------------------------------
+// Corpora
+// --------------------------------------------------------------------
+/*
+   random   uniform printable ASCII (95 symbols), short LCPs everywhere
+   dna      uniform over acgt
+   english  words of a fixed vocabulary drawn with Zipf frequencies,
+            separated by spaces with occasional punctuation
+   runs     one repeated character: every LCP is maximal
+   fibonacci  prefix of the Fibonacci word (a, ab, aba, abaab, ...), which
+            has the most repeated structure a non-periodic text can have
+            and keeps doubling busy for ~log n rounds
+   All generators are seeded, so every builder sees identical text.
+*/
+const vector<string> CORPORA = {"random", "dna", "english", "runs", "fibonacci"};
+
+string generateCorpus(const string &kind, size_t n) {
+    mt19937_64 rng(20240601);
+    string s(n, 'a');
+    if (kind == "random") {
+        for (auto &c : s) c = ' ' + rng() % 95;
+    } else if (kind == "dna") {
+        for (auto &c : s) c = "acgt"[rng() % 4];
+    } else if (kind == "english") {
+        const int V = 5000;
+        vector<string> vocabulary(V);
+        vector<double> cumulative(V);
+        double total = 0;
+        for (int w = 0; w < V; w++) {
+            int len = 1 + rng() % 3 + rng() % 4 + rng() % 4;
+            // Letters in English frequency order, skewed towards the common ones
+            for (int k = 0; k < len; k++) vocabulary[w] += "etaoinshrdlcumwfgypbvkjxqz"[min(rng() % 26, rng() % 26)];
+            total += 1.0 / (w + 1);
+            cumulative[w] = total;
+        }
+        uniform_real_distribution<double> pick(0, total);
+        size_t i = 0;
+        while (i < n) {
+            const string &word = vocabulary[lower_bound(cumulative.begin(), cumulative.end(), pick(rng)) - cumulative.begin()];
+            for (size_t k = 0; k < word.size() && i < n; k++) s[i++] = word[k];
+            if (i < n && rng() % 12 == 0) s[i++] = ",.;"[rng() % 3];
+            if (i < n) s[i++] = ' ';
+        }
+    } else if (kind == "fibonacci") {
+        // f_k = f_{k-1} f_{k-2}; grow in place since f_{k-1} is a prefix of f_k
+        string prev = "a";
+        s = "ab";
+        while (s.size() < n) {
+            string next = s + prev;
+            prev.swap(s);
+            s.swap(next);
+        }
+        s.resize(n);
+    }
+    return s;
+}
+
+// --------------------------------------------------------------------
+// Measurement: every run happens in a forked child, so peak RSS is the
+// child's own high-water mark and one builder cannot inflate another's
+// --------------------------------------------------------------------
+/*
+   fork() copies only the calling thread, so a thread pool created before
+   the fork has no workers in the child and its first run() waits forever.
+   Anything threaded must be created by build() itself, inside the child.
+*/
+struct Measurement {
+    double seconds;
+    long peakKB;
+    unsigned long long checksum;
+    int rounds;
+    bool ok;
+};
+
+template <class F>
+Measurement measureInChild(F build) {
+    int fds[2];
+    if (pipe(fds) != 0) { perror("pipe"); exit(1); }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        int rounds = 0;
+        auto start = chrono::steady_clock::now();
+        vector<int> suffixArray = build(rounds);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        unsigned long long checksum = 0;
+        for (int x : suffixArray) checksum = checksum * 1000003 + x;
+        Measurement m = {seconds, 0, checksum, rounds, true};
+        if (write(fds[1], &m, sizeof m) != (ssize_t)sizeof m) _exit(1);
+        _exit(0);
+    }
+    close(fds[1]);
+    Measurement m = {0, 0, 0, 0, false};
+    if (read(fds[0], &m, sizeof m) != (ssize_t)sizeof m) m.ok = false; // killed, e.g. out of memory
+    close(fds[0]);
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    m.peakKB = usage.ru_maxrss;
+    return m;
+}
+
+// Parses sizes such as 4096, 64K, 512M or 1G; returns 0 if x is not one
+size_t parseSize(const string &x) {
+    if (x.empty() || !isdigit((unsigned char)x[0])) return 0;
+    char *end;
+    size_t value = strtoull(x.c_str(), &end, 10);
+    string unit = end;
+    if (unit.empty()) return value;
+    if (unit.size() != 1) return 0;
+    char u = toupper(unit[0]);
+    if (u == 'K') return value << 10;
+    if (u == 'M') return value << 20;
+    if (u == 'G') return value << 30;
+    return 0;
+}
+
+string formatSize(size_t n) {
+    if (n >= (1 << 30) && n % (1 << 30) == 0) return to_string(n >> 30) + "G";
+    if (n >= (1 << 20) && n % (1 << 20) == 0) return to_string(n >> 20) + "M";
+    if (n >= (1 << 10) && n % (1 << 10) == 0) return to_string(n >> 10) + "K";
+    return to_string(n);
+}
+
+/*
+   ./sa_bench [-j threads] [-b seconds] [-c corpus,corpus,...] [sizes...]
+
+   Sizes accept K/M/G suffixes (default 1M 16M 256M 1G). For every corpus
+   and size, each builder runs once; a builder that took longer than the
+   budget (-b, default 60 s) or ran out of memory is skipped at the larger
+   sizes of that corpus. The rounds column counts doubling rounds, and
+   recursion levels for SA-IS; the check column compares each SA against
+   the first builder's.
+*/
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    int threads = thread::hardware_concurrency();
+    double budget = 60;
+    vector<string> corpora = CORPORA;
+    vector<size_t> sizes;
+    for (int a = 1; a < argc; a++) {
+        string arg = argv[a];
+        if (arg == "-j" && a + 1 < argc) threads = atoi(argv[++a]);
+        else if (arg == "-b" && a + 1 < argc) budget = atof(argv[++a]);
+        else if (arg == "-c" && a + 1 < argc) {
+            corpora.clear();
+            stringstream list(argv[++a]);
+            for (string name; getline(list, name, ',');) corpora.push_back(name);
+        } else {
+            sizes.push_back(parseSize(arg));
+            if (sizes.back() == 0) {
+                cerr << "bad size " << arg << " (expected e.g. 4096, 64K, 512M, 1G)" << endl;
+                return 1;
+            }
+            if (sizes.back() >= (size_t)INT_MAX) {
+                cerr << "size " << arg << " does not fit the 32-bit suffix array indices" << endl;
+                return 1;
+            }
+        }
+    }
+    if (sizes.empty()) sizes = {1 << 20, 16 << 20, 256 << 20, 1 << 30};
+    for (auto &name : corpora) {
+        if (find(CORPORA.begin(), CORPORA.end(), name) == CORPORA.end()) {
+            cerr << "unknown corpus " << name << endl;
+            return 1;
+        }
+    }
+
+    threads = max(1, threads);
+    string parallelName = "radix doubling x" + to_string(threads);
+    vector<string> names = {"SA-IS", "std::sort doubling", "counting doubling", parallelName};
+
+    cout << left << setw(11) << "corpus" << setw(7) << "size" << setw(22) << "builder" << setw(10) << "time (s)"
+         << setw(10) << "MB/s" << setw(15) << "peak RSS (MB)" << setw(8) << "rounds" << "check" << endl;
+    for (auto &corpus : corpora) {
+        set<string> skipped;
+        for (size_t n : sizes) {
+            string s = generateCorpus(corpus, n);
+            unsigned long long expected = 0;
+            for (int b = 0; b < (int)names.size(); b++) {
+                cout << left << setw(11) << corpus << setw(7) << formatSize(n) << setw(22) << names[b];
+                if (skipped.count(names[b])) {
+                    cout << "skipped" << endl;
+                    continue;
+                }
+                Measurement m = measureInChild([&](int &rounds) {
+                    if (b == 0) return buildSuffixArraySAIS(s, rounds);
+                    if (b == 1) return buildSuffixArraySortDoubling(s, rounds);
+                    if (b == 2) return buildSuffixArrayCyclic(s, rounds);
+                    // Created in the child (see measureInChild); spawning the threads is timed too
+                    ThreadPool pool(threads);
+                    return buildSuffixArrayParallel(s, pool, rounds);
+                });
+                if (!m.ok) {
+                    cout << "failed" << endl;
+                    skipped.insert(names[b]);
+                    continue;
+                }
+                if (b == 0) expected = m.checksum;
+                cout << setw(10) << fixed << setprecision(3) << m.seconds << setw(10) << setprecision(1)
+                     << n / 1048576.0 / max(m.seconds, 1e-9) << setw(15) << m.peakKB / 1024.0 << setw(8)
+                     << m.rounds << (m.checksum == expected ? "ok" : "MISMATCH") << endl;
+                if (m.seconds > budget) skipped.insert(names[b]);
+            }
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,445 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Persisted Suffix Array + LCP Index (memory-mapped)
+ *
+ *    Description:
+ *    lcp+suffix.cpp and Suffix_Array_and_LCP_Array.cpp rebuild the suffix and
+ *    LCP arrays on every run. This program splits that into two steps:
+ *      - build: construct SA (SA-IS) and LCP (Kasai) once and write the text
+ *        and both arrays into a versioned binary index file,
+ *      - query: mmap the index file and answer queries straight from the
+ *        mapped arrays, so startup costs a few page-table entries instead of
+ *        a rebuild, whatever the corpus size.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Suffix_Array_Index_File.cpp -o sa_index
+ *
+ *    Execution:
+ *         ./sa_index build corpus.idx corpus.bin    (every byte, NUL included)
+ *         ./sa_index build corpus.idx - < corpus.bin
+ *         ./sa_index build corpus.idx < corpus.txt  (first word of stdin)
+ *         ./sa_index query corpus.idx < queries.txt
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Function to build the LCP array using Kasai's algorithm
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+// --------------------------------------------------------------------
+// Index file layout (all offsets in bytes, every section 8-byte aligned)
+// --------------------------------------------------------------------
+/*
+   [IndexHeader][text: n bytes][pad][SA: n x int32][pad][LCP: n x int32]
+
+   The header records its own version and the width of SA/LCP entries, so
+   a reader refuses files written by an incompatible build instead of
+   misreading them. The sections are raw arrays, so the query side maps the
+   file and uses the arrays in place: no parsing and no copying.
+*/
+const char INDEX_MAGIC[8] = {'S', 'A', 'I', 'D', 'X', 0, 0, 0};
+const uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryBytes;   // width of one SA / LCP entry
+    uint64_t textLength;
+    uint64_t textOffset;
+    uint64_t saOffset;
+    uint64_t lcpOffset;
+    uint64_t fileSize;
+};
+
+uint64_t alignUp(uint64_t x) { return (x + 7) & ~7ULL; }
+
+// Writes s, its suffix array and its LCP array to path; returns false on I/O failure
+bool writeIndex(const string &path, string_view s, const vector<int> &suffixArray, const vector<int> &lcp) {
+    uint64_t n = s.size();
+    IndexHeader header = {};
+    memcpy(header.magic, INDEX_MAGIC, sizeof INDEX_MAGIC);
+    header.version = INDEX_VERSION;
+    header.entryBytes = sizeof(int32_t);
+    header.textLength = n;
+    header.textOffset = alignUp(sizeof header);
+    header.saOffset = alignUp(header.textOffset + n);
+    header.lcpOffset = alignUp(header.saOffset + n * sizeof(int32_t));
+    header.fileSize = header.lcpOffset + n * sizeof(int32_t);
+
+    FILE *out = fopen(path.c_str(), "wb");
+    if (!out) return false;
+    static const char zeros[8] = {};
+    bool ok = fwrite(&header, sizeof header, 1, out) == 1;
+    ok = ok && fwrite(zeros, 1, header.textOffset - sizeof header, out) == header.textOffset - sizeof header;
+    ok = ok && fwrite(s.data(), 1, n, out) == n;
+    ok = ok && fwrite(zeros, 1, header.saOffset - header.textOffset - n, out) == header.saOffset - header.textOffset - n;
+    ok = ok && fwrite(suffixArray.data(), sizeof(int32_t), n, out) == n;
+    ok = ok && fwrite(zeros, 1, header.lcpOffset - header.saOffset - n * sizeof(int32_t), out) ==
+                   header.lcpOffset - header.saOffset - n * sizeof(int32_t);
+    ok = ok && fwrite(lcp.data(), sizeof(int32_t), n, out) == n;
+    ok = (fclose(out) == 0) && ok;
+    return ok;
+}
+
+// --------------------------------------------------------------------
+// Read-only view of an index file mapped into memory
+// --------------------------------------------------------------------
+struct MappedIndex {
+    const char *text = nullptr;
+    const int32_t *suffixArray = nullptr;
+    const int32_t *lcp = nullptr;
+    uint64_t n = 0;
+
+    void *base = MAP_FAILED;
+    size_t length = 0;
+
+    // Maps path and validates its header; on failure returns false and fills error
+    bool open(const string &path, string &error) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open " + path; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(IndexHeader)) {
+            ::close(fd);
+            error = path + " is not an index file";
+            return false;
+        }
+        length = st.st_size;
+        base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) { error = "cannot map " + path; return false; }
+
+        const IndexHeader *header = (const IndexHeader *)base;
+        // Every section must lie inside the mapping (written so that no sum can overflow)
+        auto fits = [&](uint64_t offset, uint64_t bytes) { return offset <= length && bytes <= length - offset; };
+        if (memcmp(header->magic, INDEX_MAGIC, sizeof INDEX_MAGIC) != 0) error = path + " is not an index file";
+        else if (header->version != INDEX_VERSION) error = "unsupported index version " + to_string(header->version);
+        else if (header->entryBytes != sizeof(int32_t)) error = "unsupported entry width " + to_string(header->entryBytes);
+        else if (header->fileSize != length || header->lcpOffset + header->textLength * sizeof(int32_t) != length)
+            error = path + " is truncated";
+        else if (header->textLength >= (uint64_t)INT32_MAX || header->textOffset < sizeof(IndexHeader) ||
+                 !fits(header->textOffset, header->textLength) ||
+                 header->saOffset % 8 != 0 || !fits(header->saOffset, header->textLength * sizeof(int32_t)) ||
+                 header->lcpOffset % 8 != 0 || !fits(header->lcpOffset, header->textLength * sizeof(int32_t)))
+            error = path + " has a corrupt header";
+        if (!error.empty()) { close(); return false; }
+
+        const char *bytes = (const char *)base;
+        n = header->textLength;
+        text = bytes + header->textOffset;
+        suffixArray = (const int32_t *)(bytes + header->saOffset);
+        lcp = (const int32_t *)(bytes + header->lcpOffset);
+        // Queries binary-search the SA, so readahead would only pull in pages we never touch
+        madvise(base, length, MADV_RANDOM);
+        return true;
+    }
+
+    void close() {
+        if (base != MAP_FAILED) munmap(base, length);
+        base = MAP_FAILED;
+    }
+
+    ~MappedIndex() { close(); }
+
+    // Half-open range [lo, hi) of SA slots whose suffixes start with p
+    pair<uint64_t, uint64_t> equalRange(const string &p) const {
+        auto cmp = [&](int32_t suffix) {
+            // <0, 0, >0 as the suffix is below, prefixed by, or above p
+            uint64_t len = min<uint64_t>(p.size(), n - suffix);
+            int c = memcmp(text + suffix, p.data(), len);
+            if (c != 0) return c;
+            return len < p.size() ? -1 : 0;
+        };
+        uint64_t lo = 0, hi = n;
+        while (lo < hi) {
+            uint64_t mid = (lo + hi) / 2;
+            if (cmp(suffixArray[mid]) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        uint64_t first = lo;
+        hi = n;
+        while (lo < hi) {
+            uint64_t mid = (lo + hi) / 2;
+            if (cmp(suffixArray[mid]) <= 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return {first, lo};
+    }
+};
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+/*
+   build <index> [text]: reads the text file ("-" for all of stdin, or the
+       first word of stdin when omitted), builds SA + LCP and writes the index.
+   query <index>: maps the index and answers one query per line from stdin:
+       count <pattern>    number of occurrences
+       locate <pattern>   sorted starting positions
+       sa <i> / lcp <i>   raw array entries
+*/
+int buildMode(const string &path, const char *textPath) {
+    InputText input;
+    string word;
+    string_view s;
+    if (textPath) {
+        if (!input.open(textPath)) {
+            cerr << "cannot read " << textPath << endl;
+            return 1;
+        }
+        s = input.view();
+    } else {
+        cin >> word;
+        s = word;
+    }
+    if (s.size() >= (size_t)INT32_MAX) {
+        cerr << "text too long for 32-bit index entries" << endl;
+        return 1;
+    }
+
+    clock_t z = clock();
+    vector<int> suffixArray = buildSuffixArray(s);
+    vector<int> lcpArray = buildLCPArray(s, suffixArray);
+    if (!writeIndex(path, s, suffixArray, lcpArray)) {
+        cerr << "cannot write " << path << endl;
+        return 1;
+    }
+    cerr << "Indexed " << s.size() << " bytes in " << ((double)(clock() - z) / CLOCKS_PER_SEC) << " s" << endl;
+    return 0;
+}
+
+int queryMode(const string &path) {
+    auto start = chrono::steady_clock::now();
+    MappedIndex index;
+    string error;
+    if (!index.open(path, error)) {
+        cerr << error << endl;
+        return 1;
+    }
+    cerr << "Loaded " << index.n << " bytes in "
+         << chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1000 << " ms" << endl;
+
+    // One query per line, so a malformed line is reported without swallowing the next one
+    string line;
+    while (getline(cin, line)) {
+        istringstream fields(line);
+        string op, arg;
+        if (!(fields >> op)) continue;
+        if (!(fields >> arg)) {
+            cout << "bad query\n";
+        } else if (op == "count") {
+            auto [lo, hi] = index.equalRange(arg);
+            cout << hi - lo << "\n";
+        } else if (op == "locate") {
+            auto [lo, hi] = index.equalRange(arg);
+            vector<int32_t> positions(index.suffixArray + lo, index.suffixArray + hi);
+            sort(positions.begin(), positions.end());
+            for (int32_t p : positions) cout << p << " ";
+            cout << "\n";
+        } else if (op == "sa" || op == "lcp") {
+            uint64_t i;
+            auto [end, ec] = from_chars(arg.data(), arg.data() + arg.size(), i);
+            if (ec != errc() || end != arg.data() + arg.size()) cout << "bad query\n";
+            else if (i >= index.n) cout << "out of range\n";
+            else cout << (op == "sa" ? index.suffixArray[i] : index.lcp[i]) << "\n";
+        } else {
+            cout << "unknown query " << op << "\n";
+        }
+    }
+    return 0;
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    string mode = argc > 1 ? argv[1] : "";
+    bool valid = (mode == "build" && (argc == 3 || argc == 4)) || (mode == "query" && argc == 3);
+    if (!valid) {
+        cerr << "usage: " << argv[0] << " build <index-file> [text-file|-] | query <index-file>" << endl;
+        return 1;
+    }
+    return mode == "build" ? buildMode(argv[2], argc == 4 ? argv[3] : nullptr) : queryMode(argv[2]);
+}
\ No newline at end of file
@@ -3,6 +3,13 @@
 *
 **/
 #include <bits/stdc++.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
 #define int            long long int
@@ -43,7 +50,15 @@ using namespace std;
 //      This means the suffixes starting at indices 5, 3, 1, 0, 4, and 2 are in
 //      lexicographical order.
 //
-//    - To build the suffix array:
+//    - To build the suffix array (SA-IS, the default):
+//      a) Classify each suffix as S-type (smaller than the next suffix) or
+//         L-type, and mark the leftmost S-type positions (LMS).
+//      b) Place the LMS suffixes in their character buckets and induce the
+//         order of all L-type and then all S-type suffixes from them.
+//      c) Name the LMS substrings; if two names collide, sort the reduced
+//         string of names recursively and induce once more.
+//
+//    - Prefix doubling (compile with -DSA_DOUBLING to select it):
 //      a) Initialize the suffix array with the indices of the string.
 //      b) Sort the suffixes based on the first character.
 //      c) Iteratively sort the suffixes based on the first 2^k characters.
@@ -66,6 +81,8 @@ using namespace std;
 // Applications:
 // - Pattern matching in strings: Quickly find occurrences of a pattern.
 //   Example: Using binary search on the suffix array to find the pattern.
+//   PatternSearcher below does this in O(m + log n) by also binary-searching
+//   with precomputed LCP-left / LCP-right values (Manber-Myers).
 //
 // - Finding the longest repeated substring: Identify repeated sequences.
 //   Example: The maximum value in the LCP array gives the length of the longest
@@ -74,25 +91,79 @@ using namespace std;
 // - Solving various string-related problems efficiently:
 //   Example: Finding the number of distinct substrings, finding the lexicographical
 //   order of substrings, etc.
+//   SubstringAnalytics below gets the distinct-substring total, the longest
+//   repeated substring, the top-k most frequent substrings and n-gram counts
+//   from one stack scan over the LCP intervals.
 //
 // Tips:
 // i) Suffix array construction can be done in O(n log n) time using a combination
-//    of sorting and rank updating techniques.
+//    of sorting and rank updating techniques (O(n log^2 n) with std::sort as
+//    below), and in O(n) with SA-IS, which derives the order of every suffix
+//    from a sorted sample of LMS suffixes instead of comparing ranks.
 //
 // ii) LCP array construction using Kasai's algorithm is O(n) and leverages the
 //     previously computed suffix array and rank array to efficiently compute
 //     the LCP values.
+//
+// iii) Both passes are bound by memory traffic, so the SA, rank and LCP arrays
+//      use the narrowest entry type that fits the text (4 bytes below 4 GB,
+//      a packed 5-byte uint40 below 1 TB) instead of `int` (8 bytes here).
+//      Compile with -DSA_INDEX=<type> to force one.
+//
+// iv) Pass a file name (or "-" for stdin) to index every byte of it, NUL and
+//     whitespace included: the file is memory-mapped instead of copied, and
+//     the end of the text serves as the sentinel. Without an argument the
+//     text is the first word of the input, as before.
 ///////////////////////////////////////////////////////////
 
-// Function to build the suffix array
-vector<int> buildSuffixArray(const string &s) {
+// Index types for SA, rank and LCP entries
+//
+// The arrays hold positions and lengths below n, so their width only has to
+// fit the text: uint32_t up to 4 GB, uint40 (5 bytes) up to 1 TB, and
+// uint64_t beyond. solve() picks the narrowest one; the builders below are
+// templates on it, so every pass over these arrays moves as few bytes as
+// the text allows.
+struct uint40 {
+    uint8_t bytes[5]; // low 32 bits, then the high byte
+
+    uint40() = default;
+    uint40(unsigned long long x) {
+        uint32_t low = (uint32_t)x;
+        memcpy(bytes, &low, 4);
+        bytes[4] = (uint8_t)(x >> 32);
+    }
+    operator unsigned long long() const {
+        uint32_t low;
+        memcpy(&low, bytes, 4);
+        return low | (unsigned long long)bytes[4] << 32;
+    }
+
+    uint40 &operator++() { return *this = uint40(*this + 1ULL); }
+    uint40 &operator--() { return *this = uint40(*this - 1ULL); }
+    uint40 operator++(int32_t) { uint40 old = *this; ++*this; return old; }
+    uint40 operator--(int32_t) { uint40 old = *this; --*this; return old; }
+};
+static_assert(sizeof(uint40) == 5, "uint40 must be packed");
+
+// Largest value of Index, used as the "empty slot" marker
+template <class Index>
+Index emptyIndex() { return Index(~0ULL); }
+
+// Symbol access shared by the byte string and the reduced strings of SA-IS
+inline int symbolAt(string_view s, int i) { return (unsigned char)s[i]; }
+template <class Index>
+inline int symbolAt(const vector<Index> &s, int i) { return s[i]; }
+
+// Function to build the suffix array by prefix doubling, O(n log^2 n)
+template <class Index>
+vector<Index> buildSuffixArrayDoubling(string_view s) {
     int n = s.size();
-    vector<int> suffixArray(n), rank(n), temp(n);
+    vector<Index> suffixArray(n), rank(n), temp(n);
 
     // Initialize suffix array and rank array
     for (int i = 0; i < n; ++i) {
         suffixArray[i] = i;
-        rank[i] = s[i];
+        rank[i] = (unsigned char)s[i];
     }
 
     // Sort suffixes based on first 2^k characters
@@ -100,8 +171,8 @@ vector<int> buildSuffixArray(const string &s) {
         auto cmp = [&](int a, int b) {
             if (rank[a] != rank[b])
                 return rank[a] < rank[b];
-            int ra = (a + k < n) ? rank[a + k] : -1;
-            int rb = (b + k < n) ? rank[b + k] : -1;
+            int ra = (a + k < n) ? rank[a + k] + 1 : 0;
+            int rb = (b + k < n) ? rank[b + k] + 1 : 0;
             return ra < rb;
         };
         sort(suffixArray.begin(), suffixArray.end(), cmp);
@@ -117,10 +188,179 @@ vector<int> buildSuffixArray(const string &s) {
     return suffixArray;
 }
 
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+template <class Index, class Symbols>
+vector<Index> inducedSort(const Symbols &s, int upper) {
+    int n = s.size();
+    const Index EMPTY = emptyIndex<Index>();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {Index(0)};
+    if (n == 2)
+        return symbolAt(s, 0) < symbolAt(s, 1) ? vector<Index>{Index(0), Index(1)} : vector<Index>{Index(1), Index(0)};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        int c = symbolAt(s, i), next = symbolAt(s, i + 1);
+        isS[i] = (c == next) ? isS[i + 1] : (c < next);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<Index> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[symbolAt(s, i) + 1]++;
+        else
+            bucketS[symbolAt(s, i)]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] = bucketS[c] + bucketL[c];
+        bucketL[c + 1] = bucketL[c + 1] + bucketS[c];
+    }
+
+    vector<Index> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<Index> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), EMPTY);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[symbolAt(s, p)]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[symbolAt(s, n - 1)]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            if (suffixArray[i] == EMPTY || suffixArray[i] == 0) continue;
+            int p = suffixArray[i] - 1;
+            if (!isS[p])
+                suffixArray[bucket[symbolAt(s, p)]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            if (suffixArray[i] == EMPTY || suffixArray[i] == 0) continue;
+            int p = suffixArray[i] - 1;
+            if (isS[p])
+                suffixArray[--bucket[symbolAt(s, p) + 1]] = p;
+        }
+    };
+
+    vector<Index> lmsIndex(n, EMPTY), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<Index> sortedLms;
+    sortedLms.reserve(m);
+    for (Index p : suffixArray) {
+        if (p != EMPTY && lmsIndex[p] != EMPTY)
+            sortedLms.push_back(p);
+    }
+
+    vector<Index> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = ((int)lmsIndex[a] + 1 < m) ? (int)lms[lmsIndex[a] + 1] : n;
+        int endB = ((int)lmsIndex[b] + 1 < m) ? (int)lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && symbolAt(s, a) == symbolAt(s, b)) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && symbolAt(s, a) == symbolAt(s, b));
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+    vector<Index>().swap(lmsIndex);
+
+    vector<Index> reducedSA = inducedSort<Index>(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+template <class Index>
+vector<Index> buildSuffixArraySAIS(string_view s) {
+    return inducedSort<Index>(s, 255);
+}
+
+// Function to build the suffix array
+template <class Index>
+vector<Index> buildSuffixArray(string_view s) {
+#ifdef SA_DOUBLING
+    return buildSuffixArrayDoubling<Index>(s);
+#else
+    return buildSuffixArraySAIS<Index>(s);
+#endif
+}
+
+// Length of the common prefix of a[0..limit) and b[0..limit)
+//
+// Short matches (the common case) are compared byte by byte, so the CPU can
+// keep speculating past them; from the 9th byte on, 32 (AVX2) or 16 (SSE2)
+// bytes are compared per step and the first mismatch is the lowest zero bit
+// of the equality mask (ctz). Without SIMD, 8 bytes are compared per step as
+// 64-bit words. Build with -mavx2 or -march=native for the AVX2 path.
+inline int mismatchLength(const char *a, const char *b, int limit) {
+    int k = 0, head = min<int>(limit, 8);
+    while (k < head && a[k] == b[k]) ++k;
+    if (k < head || k == limit) return k;
+#if defined(__AVX2__)
+    for (; k + 32 <= limit; k += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + k));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + k));
+        uint32_t equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFFFFFu) return k + __builtin_ctz(~equal);
+    }
+#elif defined(__SSE2__)
+    for (; k + 16 <= limit; k += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + k));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + k));
+        uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (equal != 0xFFFFu) return k + __builtin_ctz(~equal & 0xFFFFu);
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; k + 8 <= limit; k += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + k, 8);
+        memcpy(&y, b + k, 8);
+        if (x != y) return k + __builtin_ctzll(x ^ y) / 8;
+    }
+#endif
+    while (k < limit && a[k] == b[k]) ++k;
+    return k;
+}
+
 // Function to build the LCP array using Kasai's algorithm
-vector<int> buildLCPArray(const string &s, const vector<int> &suffixArray) {
+template <class Index>
+vector<Index> buildLCPArray(string_view s, const vector<Index> &suffixArray) {
     int n = s.size();
-    vector<int> rank(n), lcp(n);
+    vector<Index> rank(n), lcp(n);
 
     // Build rank array from suffix array
     for (int i = 0; i < n; ++i) {
@@ -132,9 +372,7 @@ vector<int> buildLCPArray(const string &s, const vector<int> &suffixArray) {
     for (int i = 0; i < n; ++i) {
         if (rank[i] > 0) {
             int j = suffixArray[rank[i] - 1];
-            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
-                ++h;
-            }
+            h += mismatchLength(s.data() + i + h, s.data() + j + h, n - max(i, j) - h);
             lcp[rank[i]] = h;
             if (h > 0) --h;
         }
@@ -143,30 +381,327 @@ vector<int> buildLCPArray(const string &s, const vector<int> &suffixArray) {
     return lcp;
 }
 
-void solve() {
-    string s;
-    cin >> s;
+// Pattern search over the suffix array in O(m + log n) (Manber-Myers)
+//
+// The binary search always splits the same implicit tree of intervals
+// (L, R), starting from (-1, n). For every midpoint we precompute
+//   leftLcp[mid]  = LCP(suffix L, suffix mid)
+//   rightLcp[mid] = LCP(suffix mid, suffix R)
+// and carry l = LCP(P, suffix L), r = LCP(P, suffix R) down the search.
+// Comparing these tells us on which side P lies without touching the text,
+// so every character of P is compared successfully at most once.
+template <class Index>
+struct PatternSearcher {
+    string_view s;
+    const vector<Index> &suffixArray;
+    vector<Index> leftLcp, rightLcp;
+
+    PatternSearcher(string_view s, const vector<Index> &suffixArray, const vector<Index> &lcp)
+        : s(s), suffixArray(suffixArray), leftLcp(s.size()), rightLcp(s.size()) {
+        fillLcp(-1, s.size(), lcp);
+    }
+
+    // Returns LCP(suffix L, suffix R), 0 when either end is a virtual bound
+    int fillLcp(int L, int R, const vector<Index> &lcp) {
+        if (R - L == 1) return (L >= 0 && R < sz(s)) ? (int)lcp[R] : 0;
+        int mid = (L + R) / 2;
+        leftLcp[mid] = fillLcp(L, mid, lcp);
+        rightLcp[mid] = fillLcp(mid, R, lcp);
+        return min<int>(leftLcp[mid], rightLcp[mid]);
+    }
+
+    // First SA slot whose suffix is >= p (upper = false) or whose |p|-prefix is > p (upper = true)
+    int bound(const string &p, bool upper) const {
+        int n = s.size(), m = p.size();
+        int L = -1, R = n, l = 0, r = 0;
+        while (R - L > 1) {
+            int mid = (L + R) / 2;
+            int k, lm = leftLcp[mid], rm = rightLcp[mid];
+            if (l >= r) {
+                if (lm > l) { L = mid; continue; }
+                if (lm < l) { R = mid; r = lm; continue; }
+                k = l;
+            } else {
+                if (rm > r) { R = mid; continue; }
+                if (rm < r) { L = mid; l = rm; continue; }
+                k = r;
+            }
+            int pos = suffixArray[mid];
+            k += mismatchLength(s.data() + pos + k, p.data() + k, min(m, n - pos) - k);
+
+            bool goRight;
+            if (k == m) goRight = upper;             // suffix starts with p
+            else if (pos + k == n) goRight = true;   // suffix is a proper prefix of p
+            else goRight = (unsigned char)s[pos + k] < (unsigned char)p[k];
+            if (goRight) { L = mid; l = k; }
+            else { R = mid; r = k; }
+        }
+        return R;
+    }
+
+    // Number of occurrences of p in s
+    int count(const string &p) const {
+        return bound(p, true) - bound(p, false);
+    }
+
+    // Starting positions of every occurrence of p, in increasing order
+    vector<int> locate(const string &p) const {
+        vector<int> positions(suffixArray.begin() + bound(p, false), suffixArray.begin() + bound(p, true));
+        sort(positions.begin(), positions.end());
+        return positions;
+    }
+
+    // Batch versions: patterns are searched in sorted order, so duplicates are
+    // answered once and neighbouring searches walk the same SA and text pages
+    vector<int> countBatch(const vector<string> &patterns) const {
+        vector<int> order = sortedOrder(patterns), counts(patterns.size());
+        for (int i = 0; i < sz(order); ++i) {
+            int q = order[i];
+            if (i > 0 && patterns[q] == patterns[order[i - 1]]) counts[q] = counts[order[i - 1]];
+            else counts[q] = count(patterns[q]);
+        }
+        return counts;
+    }
+
+    vector<vector<int>> locateBatch(const vector<string> &patterns) const {
+        vector<int> order = sortedOrder(patterns);
+        vector<vector<int>> positions(patterns.size());
+        for (int i = 0; i < sz(order); ++i) {
+            int q = order[i];
+            if (i > 0 && patterns[q] == patterns[order[i - 1]]) positions[q] = positions[order[i - 1]];
+            else positions[q] = locate(patterns[q]);
+        }
+        return positions;
+    }
+
+    static vector<int> sortedOrder(const vector<string> &patterns) {
+        vector<int> order(patterns.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return patterns[a] < patterns[b]; });
+        return order;
+    }
+};
+
+// Substring statistics from one bottom-up scan of the LCP intervals
+//
+// An LCP interval [lb, rb] with value l is a maximal SA range whose suffixes
+// all share a prefix of length l; with parent value p, every prefix of
+// suffix SA[lb] with length in (p, l] occurs exactly rb - lb + 1 times and
+// nowhere else in the tree. A single suffix (rank r) is a node too, with
+// l = n - SA[r] and p = max(lcp[r], lcp[r + 1]). Every distinct substring
+// therefore belongs to exactly one node, so the stack scan below can emit
+// all statistics at once. Substrings are reported as (position, length)
+// pairs into s; nothing is allocated per substring.
+template <class Index>
+struct SubstringAnalytics {
+    struct Repeat {
+        int count, position, length, rank;
+        // Most frequent first, then longest, then lexicographically smallest
+        bool operator<(const Repeat &o) const {
+            if (count != o.count) return count > o.count;
+            if (length != o.length) return length > o.length;
+            return rank < o.rank;
+        }
+    };
+
+    const vector<Index> &suffixArray, &lcp;
+    int n;
+
+    SubstringAnalytics(const vector<Index> &suffixArray, const vector<Index> &lcp)
+        : suffixArray(suffixArray), lcp(lcp), n(suffixArray.size()) {}
+
+    // visit(l, p, lb, rb) for every node, children before parents
+    template <class Visit>
+    void forEachNode(Visit visit) const {
+        vector<pii> stack = {{0, 0}}; // (lcp value, left bound); the root has value 0
+        for (int i = 1; i <= n; ++i) {
+            int cur = i < n ? (int)lcp[i] : 0;
+
+            // Suffix of rank i - 1, bounded by its neighbours in SA order
+            visit(n - (int)suffixArray[i - 1], max<int>(lcp[i - 1], cur), i - 1, i - 1);
+
+            int lb = i - 1;
+            while (cur < stack.back().F) {
+                pii node = stack.back();
+                stack.pop_back();
+                lb = node.S;
+                visit(node.F, max(cur, stack.back().F), lb, i - 1);
+            }
+            if (cur > stack.back().F) stack.pb({cur, lb});
+        }
+    }
+
+    long long distinctSubstrings = 0;
+    Repeat longestRepeat = {0, -1, 0, 0};
+    vector<Repeat> top;
+
+    // Runs the scan once: distinct total, longest repeat, and the k most
+    // frequent substrings of length >= minLength (each node reports its
+    // longest substring). ngram(g, position, count) is called for every
+    // distinct substring whose length g is in [ngramLo, ngramHi].
+    template <class NGram>
+    void run(int k, int minLength, int ngramLo, int ngramHi, NGram ngram) {
+        distinctSubstrings = 0;
+        longestRepeat = {0, -1, 0, 0};
+        top.clear();
+        priority_queue<Repeat> heap; // worst kept repeat on top
+
+        forEachNode([&](int l, int p, int lb, int rb) {
+            if (l <= p) return;
+            int count = rb - lb + 1, position = suffixArray[lb];
+            distinctSubstrings += l - p;
+            for (int g = max(p + 1, ngramLo); g <= min(l, ngramHi); ++g) ngram(g, position, count);
+            if (count < 2) return;
+
+            Repeat repeat = {count, position, l, lb};
+            if (l > longestRepeat.length) longestRepeat = repeat;
+            if (l >= minLength && k > 0) {
+                if (sz(heap) < k) heap.push(repeat);
+                else if (repeat < heap.top()) { heap.pop(); heap.push(repeat); }
+            }
+        });
+
+        for (; !heap.empty(); heap.pop()) top.pb(heap.top());
+        reverse(top.begin(), top.end());
+    }
+};
+
+// Builds and prints SA and LCP with entries of type Index, then answers the optional queries
+template <class Index>
+void solveWithIndex(string_view s) {
     int n = s.size();
 
     // Build suffix array and LCP array
-    vector<int> suffixArray = buildSuffixArray(s);
-    vector<int> lcpArray = buildLCPArray(s, suffixArray);
+    vector<Index> suffixArray = buildSuffixArray<Index>(s);
+    vector<Index> lcpArray = buildLCPArray(s, suffixArray);
 
     cout << n << ' ';
     // Output the suffix array
     for (int i = 0; i < n; ++i) {
-        cout << suffixArray[i] << " ";
+        cout << (int)suffixArray[i] << " ";
     }
     cout << endl;
 
     // Output the LCP array
     for (int i = 0; i < n; ++i) {
-        cout << lcpArray[i] << " ";
+        cout << (int)lcpArray[i] << " ";
     }
     cout << endl;
+
+    // Optional queries: q, then q patterns; prints the count and the positions of each
+    int q;
+    if (!(cin >> q)) return;
+    vector<string> patterns(q);
+    forn(i, q) cin >> patterns[i];
+
+    PatternSearcher<Index> searcher(s, suffixArray, lcpArray);
+    vector<vector<int>> positions = searcher.locateBatch(patterns);
+    forn(i, q) {
+        cout << sz(positions[i]) << ':';
+        for (int p : positions[i]) cout << ' ' << p;
+        cout << endl;
+    }
+
+    // Optional analytics: k L lo hi -> distinct total, longest repeat,
+    // top-k substrings of length >= L, then every n-gram with lo <= n <= hi
+    int k, minLength, ngramLo, ngramHi;
+    if (!(cin >> k >> minLength >> ngramLo >> ngramHi)) return;
+    SubstringAnalytics<Index> analytics(suffixArray, lcpArray);
+    ostringstream ngrams;
+    analytics.run(k, minLength, ngramLo, ngramHi, [&](int g, int position, int count) {
+        ngrams << g << ' ' << count << ' ';
+        ngrams.write(s.data() + position, g);
+        ngrams << '\n';
+    });
+
+    cout << "distinct: " << analytics.distinctSubstrings << endl;
+    auto print = [&](const typename SubstringAnalytics<Index>::Repeat &r) {
+        cout << r.count << ' ' << r.length << ' ';
+        cout.write(s.data() + max<int>(r.position, 0), r.length);
+        cout << endl;
+    };
+    cout << "longest repeated: ";
+    print(analytics.longestRepeat);
+    for (auto &r : analytics.top) print(r);
+    cout << ngrams.str();
+}
+
+// Binary-safe text input
+//
+// The text is every byte of a file, memory-mapped so it is never copied, or
+// of stdin (mapped as well when it is a regular file, otherwise read in 1 MB
+// blocks). NUL, whitespace and newlines are ordinary symbols. The end of the
+// text acts as the sentinel, so no '$' is appended and no byte is reserved.
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// path == nullptr: the text is the first word of stdin and the queries follow it.
+// Otherwise the text is every byte of the file (or of stdin for "-") and the
+// queries, if any, are read from stdin.
+void solve(const char *path) {
+    InputText input;
+    string word;
+    string_view s;
+    if (path) {
+        if (!input.open(path)) {
+            cerr << "cannot read " << path << endl;
+            return;
+        }
+        s = input.view();
+    } else {
+        cin >> word;
+        s = word;
+    }
+
+    // Narrowest entry type that can hold every position plus the empty marker
+#ifdef SA_INDEX
+    solveWithIndex<SA_INDEX>(s);
+#else
+    unsigned long long n = s.size();
+    if (n < 0xFFFFFFFFULL) solveWithIndex<uint32_t>(s);
+    else if (n < (1ULL << 40) - 1) solveWithIndex<uint40>(s);
+    else solveWithIndex<uint64_t>(s);
+#endif
 }
 
-int32_t main() {
+int32_t main(int32_t argc, char *argv[]) {
     ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
 
 #ifndef ONLINE_JUDGE
@@ -177,7 +712,7 @@ int32_t main() {
     int t = 1;
     //cin >> t;
     while (t--) {
-        solve();
+        solve(argc > 1 ? argv[1] : nullptr);
     }
     cerr << "Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC);
     return 0;
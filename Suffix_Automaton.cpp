@@ -0,0 +1,184 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Online Suffix Automaton (append-only text)
+ *
+ *    Description:
+ *    The suffix array programs need the whole string before they can start.
+ *    A suffix automaton is built online instead: append(c) extends the index
+ *    of the current prefix by one character in amortized O(1) (times the
+ *    O(log sigma) map lookup), so a growing log never has to be rebuilt.
+ *    Queries on the current prefix:
+ *      - contains(p): is p a substring, O(|p|).
+ *      - occurrences(p): how many times p occurs, O(|p|) while the text
+ *        is unchanged. The endpos sizes are not maintained by append: the
+ *        first count after any append recomputes all of them, O(states)
+ *        (at most 2n). A stream that alternates appends and counts thus
+ *        pays O(n) per count; batch the appends, or use contains() when
+ *        presence is enough, to keep counting cheap.
+ *      - distinctSubstrings(): maintained while appending, O(1).
+ *
+ *    Input, one command per line:
+ *         + text      append text
+ *         ? p         1 if p occurs in the text so far, else 0
+ *         # p         number of occurrences of p
+ *         d           number of distinct non-empty substrings
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall Suffix_Automaton.cpp -o suffix_automaton
+ *
+ *    Execution:
+ *         ./suffix_automaton < input.txt
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// --------------------------------------------------------------------
+// Suffix automaton
+// --------------------------------------------------------------------
+/*
+   Every state is a class of substrings with the same set of end
+   positions; len is the longest of them and link points to the state of
+   the longest suffix that falls in a different class. The substrings of
+   a state are the suffixes of its longest one with lengths in
+   (len[link], len], which is why appending character c adds exactly
+   len[cur] - len[link[cur]] new distinct substrings: the clone created by
+   a split only relabels substrings that already existed.
+*/
+class SuffixAutomaton {
+public:
+    SuffixAutomaton() { newState(0, -1, false); }
+
+    void append(char c) {
+        int cur = newState(len[last] + 1, -1, false);
+        int p = last;
+        while (p != -1 && !next[p].count(c)) {
+            next[p][c] = cur;
+            p = link[p];
+        }
+        if (p == -1) {
+            link[cur] = 0;
+        } else {
+            int q = next[p][c];
+            if (len[p] + 1 == len[q]) {
+                link[cur] = q;
+            } else {
+                // Split q: the clone takes the shorter substrings ending in c
+                int clone = newState(len[p] + 1, link[q], true);
+                next[clone] = next[q];
+                while (p != -1 && next[p][c] == q) {
+                    next[p][c] = clone;
+                    p = link[p];
+                }
+                link[q] = link[cur] = clone;
+            }
+        }
+        last = cur;
+        distinct += len[cur] - len[link[cur]];
+        countsDirty = true;
+    }
+
+    void append(const string &s) {
+        for (char c : s) append(c);
+    }
+
+    bool contains(const string &p) const { return walk(p) != -1; }
+
+    // O(|p|), plus an O(states) recount if anything was appended since the last count
+    long long occurrences(const string &p) {
+        int state = walk(p);
+        if (state == -1) return 0;
+        if (countsDirty) recomputeCounts();
+        return endposSize[state];
+    }
+
+    long long distinctSubstrings() const { return distinct; }
+
+    long long length() const { return len[last]; }
+
+    int size() const { return len.size(); }
+
+private:
+    int newState(int length, int suffixLink, bool isClone) {
+        len.push_back(length);
+        link.push_back(suffixLink);
+        next.emplace_back();
+        cloned.push_back(isClone);
+        return len.size() - 1;
+    }
+
+    // State reached by reading p from the root, or -1 if p is not a substring
+    int walk(const string &p) const {
+        int state = 0;
+        for (char c : p) {
+            auto it = next[state].find(c);
+            if (it == next[state].end()) return -1;
+            state = it->second;
+        }
+        return state;
+    }
+
+    // endpos sizes: 1 for every non-clone state, summed up the suffix-link tree
+    /*
+       Children are longer than their link, so visiting states in
+       decreasing len (a counting sort on len) processes every child before
+       its parent. This is a full pass on purpose: an append adds one end
+       position to every state on the suffix-link path of the new state,
+       which is itself O(n) long on texts like "aaaa...", so keeping the
+       counts current on every append would cost as much as recounting.
+    */
+    void recomputeCounts() {
+        int states = size();
+        int maxLen = len[last];
+        vector<int> bucket(maxLen + 2, 0), order(states);
+        for (int v = 0; v < states; v++) bucket[len[v] + 1]++;
+        for (int l = 0; l <= maxLen; l++) bucket[l + 1] += bucket[l];
+        for (int v = 0; v < states; v++) order[bucket[len[v]]++] = v;
+
+        endposSize.assign(states, 0);
+        for (int v = 1; v < states; v++) endposSize[v] = !cloned[v];
+        for (int i = states - 1; i > 0; i--) {
+            int v = order[i];
+            endposSize[link[v]] += endposSize[v];
+        }
+        countsDirty = false;
+    }
+
+    vector<int> len, link;
+    vector<map<char, int>> next;
+    vector<bool> cloned;
+    vector<long long> endposSize;
+    int last = 0;
+    long long distinct = 0;
+    bool countsDirty = false;
+};
+
+void solve() {
+    SuffixAutomaton sam;
+    string line;
+    while (getline(cin, line)) {
+        if (line.empty()) continue;
+        char op = line[0];
+        string arg = line.size() > 2 ? line.substr(2) : "";
+        if (op == '+') {
+            sam.append(arg);
+        } else if (op == '?') {
+            cout << sam.contains(arg) << '\n';
+        } else if (op == '#') {
+            cout << sam.occurrences(arg) << '\n';
+        } else if (op == 'd') {
+            cout << sam.distinctSubstrings() << '\n';
+        }
+    }
+    cerr << "Length : " << sam.length() << ", States : " << sam.size() << endl;
+}
+
+int32_t main() {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+
+    clock_t z = clock();
+    solve();
+    cerr << "Run Time : " << ((double)(clock() - z) / CLOCKS_PER_SEC) << endl;
+    return 0;
+}
\ No newline at end of file
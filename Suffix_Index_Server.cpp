@@ -0,0 +1,956 @@
+/**
+ *    Author: devesh95
+ *
+ *    Topic: Suffix Index Query Server (Unix domain socket)
+ *
+ *    Description:
+ *    Keeps one suffix array + LCP index resident and answers count, locate
+ *    and LCP(i, j) queries for other processes, so no query pays for
+ *    construction or loading. The index file is the one written by
+ *    Suffix_Array_Index_File.cpp (built here on first start if missing) and
+ *    is mmapped; LCP of two arbitrary suffixes uses a block RMQ over the
+ *    mapped LCP array.
+ *      - compact binary protocol over a local stream socket,
+ *      - one poll() loop owns every connection and hands batches of
+ *        complete requests to a fixed pool of worker threads, so idle
+ *        clients cost a descriptor, not a worker,
+ *      - pipelining: a client may send any number of requests before
+ *        reading; responses come back in order and in batches.
+ *
+ *    Compilation:
+ *         g++ -std=c++17 -O2 -Wall -pthread Suffix_Index_Server.cpp -o sa_server
+ *
+ *    Execution:
+ *         ./sa_server serve corpus.idx /tmp/sa.sock [workers] < corpus.bin  (every byte)
+ *         ./sa_server client /tmp/sa.sock < queries.txt
+ */
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper) {
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i) {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms) {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms) {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i) {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray) {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i) {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same) {
+            while (a < endA && s[a] == s[b]) {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i) {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArray(string_view s) {
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols) {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Function to build the LCP array using Kasai's algorithm
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray) {
+    int n = s.size();
+    vector<int> rank(n), lcp(n);
+
+    // Build rank array from suffix array
+    for (int i = 0; i < n; ++i) {
+        rank[suffixArray[i]] = i;
+    }
+
+    int h = 0;
+    // Build LCP array
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] > 0) {
+            int j = suffixArray[rank[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+                ++h;
+            }
+            lcp[rank[i]] = h;
+            if (h > 0) --h;
+        }
+    }
+
+    return lcp;
+}
+
+// --------------------------------------------------------------------
+// Index file layout (all offsets in bytes, every section 8-byte aligned)
+// --------------------------------------------------------------------
+/*
+   [IndexHeader][text: n bytes][pad][SA: n x int32][pad][LCP: n x int32]
+
+   The header records its own version and the width of SA/LCP entries, so
+   a reader refuses files written by an incompatible build instead of
+   misreading them. The sections are raw arrays, so the query side maps the
+   file and uses the arrays in place: no parsing and no copying.
+*/
+const char INDEX_MAGIC[8] = {'S', 'A', 'I', 'D', 'X', 0, 0, 0};
+const uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryBytes;   // width of one SA / LCP entry
+    uint64_t textLength;
+    uint64_t textOffset;
+    uint64_t saOffset;
+    uint64_t lcpOffset;
+    uint64_t fileSize;
+};
+
+uint64_t alignUp(uint64_t x) { return (x + 7) & ~7ULL; }
+
+// Writes s, its suffix array and its LCP array to path; returns false on I/O failure
+bool writeIndex(const string &path, string_view s, const vector<int> &suffixArray, const vector<int> &lcp) {
+    uint64_t n = s.size();
+    IndexHeader header = {};
+    memcpy(header.magic, INDEX_MAGIC, sizeof INDEX_MAGIC);
+    header.version = INDEX_VERSION;
+    header.entryBytes = sizeof(int32_t);
+    header.textLength = n;
+    header.textOffset = alignUp(sizeof header);
+    header.saOffset = alignUp(header.textOffset + n);
+    header.lcpOffset = alignUp(header.saOffset + n * sizeof(int32_t));
+    header.fileSize = header.lcpOffset + n * sizeof(int32_t);
+
+    FILE *out = fopen(path.c_str(), "wb");
+    if (!out) return false;
+    static const char zeros[8] = {};
+    bool ok = fwrite(&header, sizeof header, 1, out) == 1;
+    ok = ok && fwrite(zeros, 1, header.textOffset - sizeof header, out) == header.textOffset - sizeof header;
+    ok = ok && fwrite(s.data(), 1, n, out) == n;
+    ok = ok && fwrite(zeros, 1, header.saOffset - header.textOffset - n, out) == header.saOffset - header.textOffset - n;
+    ok = ok && fwrite(suffixArray.data(), sizeof(int32_t), n, out) == n;
+    ok = ok && fwrite(zeros, 1, header.lcpOffset - header.saOffset - n * sizeof(int32_t), out) ==
+                   header.lcpOffset - header.saOffset - n * sizeof(int32_t);
+    ok = ok && fwrite(lcp.data(), sizeof(int32_t), n, out) == n;
+    ok = (fclose(out) == 0) && ok;
+    return ok;
+}
+
+// --------------------------------------------------------------------
+// Read-only view of an index file mapped into memory
+// --------------------------------------------------------------------
+struct MappedIndex {
+    const char *text = nullptr;
+    const int32_t *suffixArray = nullptr;
+    const int32_t *lcp = nullptr;
+    uint64_t n = 0;
+
+    void *base = MAP_FAILED;
+    size_t length = 0;
+
+    // Maps path and validates its header; on failure returns false and fills error
+    bool open(const string &path, string &error) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open " + path; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(IndexHeader)) {
+            ::close(fd);
+            error = path + " is not an index file";
+            return false;
+        }
+        length = st.st_size;
+        base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) { error = "cannot map " + path; return false; }
+
+        const IndexHeader *header = (const IndexHeader *)base;
+        // Every section must lie inside the mapping (written so that no sum can overflow)
+        auto fits = [&](uint64_t offset, uint64_t bytes) { return offset <= length && bytes <= length - offset; };
+        if (memcmp(header->magic, INDEX_MAGIC, sizeof INDEX_MAGIC) != 0) error = path + " is not an index file";
+        else if (header->version != INDEX_VERSION) error = "unsupported index version " + to_string(header->version);
+        else if (header->entryBytes != sizeof(int32_t)) error = "unsupported entry width " + to_string(header->entryBytes);
+        else if (header->fileSize != length || header->lcpOffset + header->textLength * sizeof(int32_t) != length)
+            error = path + " is truncated";
+        else if (header->textLength >= (uint64_t)INT32_MAX || header->textOffset < sizeof(IndexHeader) ||
+                 !fits(header->textOffset, header->textLength) ||
+                 header->saOffset % 8 != 0 || !fits(header->saOffset, header->textLength * sizeof(int32_t)) ||
+                 header->lcpOffset % 8 != 0 || !fits(header->lcpOffset, header->textLength * sizeof(int32_t)))
+            error = path + " has a corrupt header";
+        if (!error.empty()) { close(); return false; }
+
+        const char *bytes = (const char *)base;
+        n = header->textLength;
+        text = bytes + header->textOffset;
+        suffixArray = (const int32_t *)(bytes + header->saOffset);
+        lcp = (const int32_t *)(bytes + header->lcpOffset);
+        // Queries binary-search the SA, so readahead would only pull in pages we never touch
+        madvise(base, length, MADV_RANDOM);
+        return true;
+    }
+
+    void close() {
+        if (base != MAP_FAILED) munmap(base, length);
+        base = MAP_FAILED;
+    }
+
+    ~MappedIndex() { close(); }
+
+    // Half-open range [lo, hi) of SA slots whose suffixes start with p
+    pair<uint64_t, uint64_t> equalRange(const string &p) const {
+        auto cmp = [&](int32_t suffix) {
+            // <0, 0, >0 as the suffix is below, prefixed by, or above p
+            uint64_t len = min<uint64_t>(p.size(), n - suffix);
+            int c = memcmp(text + suffix, p.data(), len);
+            if (c != 0) return c;
+            return len < p.size() ? -1 : 0;
+        };
+        uint64_t lo = 0, hi = n;
+        while (lo < hi) {
+            uint64_t mid = (lo + hi) / 2;
+            if (cmp(suffixArray[mid]) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        uint64_t first = lo;
+        hi = n;
+        while (lo < hi) {
+            uint64_t mid = (lo + hi) / 2;
+            if (cmp(suffixArray[mid]) <= 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return {first, lo};
+    }
+};
+
+// --------------------------------------------------------------------
+// O(1) LCP of two suffixes: block RMQ over the mapped LCP array
+// --------------------------------------------------------------------
+/*
+   Same structure as LCP_RMQ.cpp, but reading the LCP section of the index
+   file in place. Blocks of 64 keep a bitmask of their increasing minimum
+   stack; block minima go into a sparse table. rank[] is the inverse SA,
+   rebuilt once at startup because the index file does not store it.
+*/
+struct BlockRMQ {
+    static const int B = 64;
+    const int32_t *a = nullptr;
+    vector<uint64_t> masks;
+    vector<vector<int32_t>> table; // sparse table over block minima
+
+    void build(const int32_t *values, int n) {
+        a = values;
+        masks.assign(n, 0);
+        vector<int32_t> minima((n + B - 1) / B);
+        vector<int> stack;
+        for (int start = 0; start < n; start += B) {
+            int end = min(n, start + B);
+            uint64_t mask = 0;
+            stack.clear();
+            for (int i = start; i < end; i++) {
+                while (!stack.empty() && values[stack.back()] >= values[i]) {
+                    mask ^= 1ULL << (stack.back() - start);
+                    stack.pop_back();
+                }
+                mask |= 1ULL << (i - start);
+                stack.push_back(i);
+                masks[i] = mask;
+            }
+            minima[start / B] = values[stack.front()];
+        }
+        int m = minima.size();
+        table.assign(1, minima);
+        for (int k = 1; (1 << k) <= m; k++) {
+            const vector<int32_t> &prev = table[k - 1];
+            vector<int32_t> level(m - (1 << k) + 1);
+            for (int i = 0; i + (1 << k) <= m; i++) level[i] = min(prev[i], prev[i + (1 << (k - 1))]);
+            table.push_back(move(level));
+        }
+    }
+
+    int inBlock(int l, int r) const {
+        uint64_t m = masks[r] >> (l % B);
+        return a[l + __builtin_ctzll(m)];
+    }
+
+    // Minimum of a[l..r], l <= r
+    int query(int l, int r) const {
+        int bl = l / B, br = r / B;
+        if (bl == br) return inBlock(l, r);
+        int best = min(inBlock(l, bl * B + B - 1), inBlock(br * B, r));
+        if (bl + 1 < br) {
+            int k = 31 - __builtin_clz(br - bl - 1);
+            best = min({best, (int)table[k][bl + 1], (int)table[k][br - (1 << k)]});
+        }
+        return best;
+    }
+};
+
+// --------------------------------------------------------------------
+// Query engine: everything a worker needs, read-only after startup
+// --------------------------------------------------------------------
+struct QueryEngine {
+    MappedIndex index;
+    vector<int32_t> rank;
+    BlockRMQ rmq;
+
+    bool open(const string &path, string &error) {
+        if (!index.open(path, error)) return false;
+        int n = index.n;
+        // The header is sound; the SA itself must still be a permutation of [0, n)
+        rank.assign(n, -1);
+        for (int r = 0; r < n; r++) {
+            int32_t suffix = index.suffixArray[r];
+            if (suffix < 0 || suffix >= n || rank[suffix] != -1) {
+                error = path + " has a corrupt suffix array";
+                index.close();
+                return false;
+            }
+            rank[suffix] = r;
+        }
+        rmq.build(index.lcp, n);
+        return true;
+    }
+
+    uint64_t count(const string &p) const {
+        auto [lo, hi] = index.equalRange(p);
+        return hi - lo;
+    }
+
+    // Sorted positions of p (the first `limit` of them when limit > 0); returns the total
+    uint64_t locate(const string &p, uint32_t limit, vector<int32_t> &positions) const {
+        auto [lo, hi] = index.equalRange(p);
+        positions.assign(index.suffixArray + lo, index.suffixArray + hi);
+        if (limit > 0 && limit < positions.size()) {
+            partial_sort(positions.begin(), positions.begin() + limit, positions.end());
+            positions.resize(limit);
+        } else {
+            sort(positions.begin(), positions.end());
+        }
+        return hi - lo;
+    }
+
+    // LCP of the suffixes starting at text positions i and j (both < n)
+    uint64_t lcp(uint64_t i, uint64_t j) const {
+        if (i == j) return index.n - i;
+        int ri = rank[i], rj = rank[j];
+        if (ri > rj) swap(ri, rj);
+        return rmq.query(ri + 1, rj);
+    }
+};
+
+// --------------------------------------------------------------------
+// Wire protocol (native byte order: the socket is local to the machine)
+// --------------------------------------------------------------------
+/*
+   Request:  [u32 bodyLength][u8 op][body]
+       OP_COUNT   body = pattern bytes
+       OP_LOCATE  body = u32 limit (0 = all), pattern bytes
+       OP_LCP     body = u64 i, u64 j
+   Response: [u32 bodyLength][u8 status][body]
+       OP_COUNT   u64 count
+       OP_LOCATE  u64 total, u32 returned, returned x i32 positions (sorted)
+       OP_LCP     u64 length
+   bodyLength counts the bytes after the length field (op/status included).
+   Responses come back in request order, so a client may keep any number
+   of requests in flight on one connection (pipelining) and match them up
+   by position.
+*/
+enum : uint8_t { OP_COUNT = 1, OP_LOCATE = 2, OP_LCP = 3 };
+enum : uint8_t { STATUS_OK = 0, STATUS_BAD_REQUEST = 1 };
+const uint32_t MAX_FRAME = 1 << 20;
+
+template <class T>
+void putValue(string &out, T value) { out.append((const char *)&value, sizeof value); }
+
+template <class T>
+T getValue(const char *p) {
+    T value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+// Appends a response frame to out for the request with the given op and body
+void answer(const QueryEngine &engine, uint8_t op, const char *body, uint32_t length, string &out,
+            vector<int32_t> &scratch) {
+    size_t start = out.size();
+    putValue<uint32_t>(out, 0); // patched below
+    putValue<uint8_t>(out, STATUS_OK);
+    if (op == OP_COUNT) {
+        putValue<uint64_t>(out, engine.count(string(body, length)));
+    } else if (op == OP_LOCATE && length >= 4) {
+        uint32_t limit = getValue<uint32_t>(body);
+        uint64_t total = engine.locate(string(body + 4, length - 4), limit, scratch);
+        putValue<uint64_t>(out, total);
+        putValue<uint32_t>(out, scratch.size());
+        out.append((const char *)scratch.data(), scratch.size() * sizeof(int32_t));
+    } else if (op == OP_LCP && length == 16 && getValue<uint64_t>(body) < engine.index.n &&
+               getValue<uint64_t>(body + 8) < engine.index.n) {
+        putValue<uint64_t>(out, engine.lcp(getValue<uint64_t>(body), getValue<uint64_t>(body + 8)));
+    } else {
+        out[start + 4] = STATUS_BAD_REQUEST;
+    }
+    uint32_t bodyLength = out.size() - start - 4;
+    memcpy(&out[start], &bodyLength, 4);
+}
+
+bool writeAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t k = write(fd, data, length);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return false;
+        data += k;
+        length -= k;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------
+// Server: one poll() loop for every connection, a fixed pool of workers
+// --------------------------------------------------------------------
+/*
+   The event loop owns all sockets. It reads whatever a client has sent,
+   and once the buffer holds complete requests it hands all of them to the
+   pool as one batch. A worker answers the batch into a single response
+   buffer and passes it back through a pipe that wakes the loop, which
+   writes it out. A connection has at most one batch in flight, so
+   responses leave in request order and requests that arrive meanwhile
+   wait for the next batch. A pipelining client gets its queries batched
+   both ways, and a client that sends nothing holds no worker. A
+   connection is not read from while more than MAX_BUFFERED bytes of its
+   requests or responses are waiting.
+*/
+const size_t MAX_BUFFERED = 8 << 20;
+
+struct Batch {
+    int fd;
+    string requests;   // complete request frames
+    string responses;
+};
+
+// Answers every frame of a batch (the frames were checked by the event loop)
+void answerAll(const QueryEngine &engine, Batch &batch, vector<int32_t> &scratch) {
+    const string &in = batch.requests;
+    for (size_t at = 0; at < in.size();) {
+        uint32_t bodyLength = getValue<uint32_t>(in.data() + at);
+        const char *frame = in.data() + at + 4;
+        answer(engine, (uint8_t)frame[0], frame + 1, bodyLength - 1, batch.responses, scratch);
+        at += 4 + bodyLength;
+    }
+}
+
+class WorkerPool {
+public:
+    WorkerPool(const QueryEngine &engine, int numWorkers, int wakeFd) : engine(engine), wakeFd(wakeFd) {
+        for (int t = 0; t < numWorkers; t++) workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    void submit(Batch batch) {
+        {
+            lock_guard<mutex> lock(mtx);
+            pending.push(move(batch));
+        }
+        ready.notify_one();
+    }
+
+    // Batches answered since the last call
+    vector<Batch> takeFinished() {
+        lock_guard<mutex> lock(mtx);
+        vector<Batch> done;
+        done.swap(finished);
+        return done;
+    }
+
+private:
+    void workerLoop() {
+        vector<int32_t> scratch;
+        while (true) {
+            Batch batch;
+            {
+                unique_lock<mutex> lock(mtx);
+                ready.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (stopping) return;
+                batch = move(pending.front());
+                pending.pop();
+            }
+            answerAll(engine, batch, scratch);
+            {
+                lock_guard<mutex> lock(mtx);
+                finished.push_back(move(batch));
+            }
+            // A full pipe already wakes the loop, so a failed write loses nothing
+            char signal = 0;
+            while (write(wakeFd, &signal, 1) < 0 && errno == EINTR) {}
+        }
+    }
+
+    const QueryEngine &engine;
+    int wakeFd;
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable ready;
+    queue<Batch> pending;
+    vector<Batch> finished;
+    bool stopping = false;
+};
+
+struct Connection {
+    string in, out;
+    size_t written = 0;    // bytes of out already sent
+    bool busy = false;     // a batch of this connection is with the workers
+    bool eof = false;      // the client will send nothing more
+    bool broken = false;   // bad frame or I/O error: close once no batch is in flight
+};
+
+// Length of the prefix of in made of complete frames; marks c broken on a bad length
+size_t completeFrames(Connection &c) {
+    size_t at = 0;
+    while (c.in.size() - at >= 4) {
+        uint32_t bodyLength = getValue<uint32_t>(c.in.data() + at);
+        if (bodyLength == 0 || bodyLength > MAX_FRAME) {
+            c.broken = true;
+            return 0;
+        }
+        if (c.in.size() - at - 4 < bodyLength) break;
+        at += 4 + bodyLength;
+    }
+    return at;
+}
+
+void readAvailable(int fd, Connection &c) {
+    char chunk[1 << 16];
+    while (c.in.size() < MAX_BUFFERED) {
+        ssize_t k = read(fd, chunk, sizeof chunk);
+        if (k < 0 && errno == EINTR) continue;
+        if (k < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        if (k < 0) c.broken = true;
+        if (k == 0) c.eof = true;
+        if (k <= 0) return;
+        c.in.append(chunk, k);
+    }
+}
+
+void writeAvailable(int fd, Connection &c) {
+    while (c.written < c.out.size()) {
+        ssize_t k = write(fd, c.out.data() + c.written, c.out.size() - c.written);
+        if (k < 0 && errno == EINTR) continue;
+        if (k < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        if (k <= 0) {
+            c.broken = true;
+            return;
+        }
+        c.written += k;
+    }
+    c.out.clear();
+    c.written = 0;
+}
+
+bool setNonBlocking(int fd) { return fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0; }
+
+// Serves until poll() fails; returns only on error
+void eventLoop(int listenFd, int wakeFd, WorkerPool &pool) {
+    unordered_map<int, Connection> connections;
+    vector<pollfd> fds;
+    while (true) {
+        fds.assign({{listenFd, POLLIN, 0}, {wakeFd, POLLIN, 0}});
+        for (auto &[fd, c] : connections) {
+            short events = 0;
+            if (!c.eof && !c.broken && c.in.size() < MAX_BUFFERED && c.out.size() < MAX_BUFFERED) events |= POLLIN;
+            if (c.written < c.out.size()) events |= POLLOUT;
+            if (events) fds.push_back({fd, events, 0});
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            cerr << "poll failed" << endl;
+            return;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(listenFd, nullptr, nullptr)) >= 0) {
+                if (setNonBlocking(fd)) connections[fd];
+                else close(fd);
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            char drain[256];
+            while (read(wakeFd, drain, sizeof drain) > 0) {}
+            for (Batch &batch : pool.takeFinished()) {
+                Connection &c = connections[batch.fd];
+                c.busy = false;
+                c.out += batch.responses;
+            }
+        }
+        for (size_t k = 2; k < fds.size(); k++) {
+            Connection &c = connections[fds[k].fd];
+            if (fds[k].revents & (POLLIN | POLLHUP | POLLERR)) readAvailable(fds[k].fd, c);
+        }
+
+        // Dispatch, write and retire every connection that can move
+        for (auto it = connections.begin(); it != connections.end();) {
+            int fd = it->first;
+            Connection &c = it->second;
+            if (!c.busy && !c.broken) {
+                size_t length = completeFrames(c);
+                if (length > 0) {
+                    pool.submit({fd, c.in.substr(0, length), string()});
+                    c.in.erase(0, length);
+                    c.busy = true;
+                }
+            }
+            if (!c.broken && c.written < c.out.size()) writeAvailable(fd, c);
+            if (!c.busy && (c.broken || (c.eof && c.out.empty() && completeFrames(c) == 0))) {
+                close(fd);
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+int listenOn(const string &socketPath) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof addr.sun_path) return -1;
+    strcpy(addr.sun_path, socketPath.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    unlink(socketPath.c_str());
+    if (bind(fd, (sockaddr *)&addr, sizeof addr) != 0 || listen(fd, 128) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int connectTo(const string &socketPath) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof addr.sun_path) return -1;
+    strcpy(addr.sun_path, socketPath.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (sockaddr *)&addr, sizeof addr) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+/*
+   serve <index> <socket> [workers]: maps the index (building it first from
+   every byte of stdin if the file does not exist) and serves queries until
+   killed.
+*/
+int serveMode(const string &indexPath, const string &socketPath, int numWorkers) {
+    if (access(indexPath.c_str(), F_OK) != 0) {
+        InputText input;
+        if (!input.open("-")) {
+            cerr << "cannot read the text from stdin" << endl;
+            return 1;
+        }
+        string_view s = input.view();
+        if (s.size() >= (size_t)INT32_MAX) {
+            cerr << "text too long for 32-bit index entries" << endl;
+            return 1;
+        }
+        vector<int> suffixArray = buildSuffixArray(s);
+        vector<int> lcpArray = buildLCPArray(s, suffixArray);
+        if (!writeIndex(indexPath, s, suffixArray, lcpArray)) {
+            cerr << "cannot write " << indexPath << endl;
+            return 1;
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    QueryEngine engine;
+    string error;
+    if (!engine.open(indexPath, error)) {
+        cerr << error << endl;
+        return 1;
+    }
+    int listenFd = listenOn(socketPath);
+    int wake[2];
+    if (listenFd < 0 || !setNonBlocking(listenFd)) {
+        cerr << "cannot listen on " << socketPath << endl;
+        return 1;
+    }
+    if (pipe(wake) != 0 || !setNonBlocking(wake[0]) || !setNonBlocking(wake[1])) {
+        cerr << "cannot create the wake-up pipe" << endl;
+        return 1;
+    }
+    cerr << "Serving " << engine.index.n << " bytes on " << socketPath << " with " << numWorkers
+         << " workers, ready in " << chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1000
+         << " ms" << endl;
+
+    WorkerPool pool(engine, numWorkers, wake[1]);
+    eventLoop(listenFd, wake[0], pool);
+    close(listenFd);
+    return 1;
+}
+
+// Parses a whole field as an unsigned decimal number
+bool parseNumber(const string &field, uint64_t &value) {
+    auto [end, ec] = from_chars(field.data(), field.data() + field.size(), value);
+    return ec == errc() && end == field.data() + field.size();
+}
+
+/*
+   client <socket>: reads text queries from stdin, one per line (count <p>,
+   locate <p>, lcp <i> <j>), sends them all pipelined from a writer thread
+   while the main thread reads the responses, and prints one answer per
+   line in the format of sa_index query. A malformed line is answered with
+   "bad query" (or "unknown query <op>") locally and never sent.
+*/
+int clientMode(const string &socketPath) {
+    vector<string> frames;
+    vector<string> localAnswer; // per query line: empty if it was sent as frames[k], in order
+    string line;
+    while (getline(cin, line)) {
+        istringstream fields(line);
+        string op, arg, extra;
+        if (!(fields >> op)) continue;
+        string body;
+        uint64_t i, j;
+        if (!(fields >> arg)) {
+            localAnswer.push_back("bad query");
+        } else if (op == "count" || op == "locate") {
+            putValue<uint8_t>(body, op == "count" ? OP_COUNT : OP_LOCATE);
+            if (op == "locate") putValue<uint32_t>(body, 0);
+            body += arg;
+        } else if (op == "lcp") {
+            if (parseNumber(arg, i) && fields >> extra && parseNumber(extra, j)) {
+                putValue<uint8_t>(body, OP_LCP);
+                putValue<uint64_t>(body, i);
+                putValue<uint64_t>(body, j);
+            } else {
+                localAnswer.push_back("bad query");
+            }
+        } else {
+            localAnswer.push_back("unknown query " + op);
+        }
+        if (body.empty()) continue;
+        string frame;
+        putValue<uint32_t>(frame, body.size());
+        frames.push_back(frame + body);
+        localAnswer.emplace_back();
+    }
+
+    int fd = connectTo(socketPath);
+    if (fd < 0) {
+        cerr << "cannot connect to " << socketPath << endl;
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    thread writer([&] {
+        string batch;
+        for (auto &frame : frames) {
+            batch += frame;
+            if (batch.size() >= (1 << 16)) {
+                if (!writeAll(fd, batch.data(), batch.size())) return;
+                batch.clear();
+            }
+        }
+        writeAll(fd, batch.data(), batch.size());
+    });
+
+    FILE *responses = fdopen(dup(fd), "rb");
+    auto readExactly = [&](void *p, size_t length) { return fread(p, 1, length, responses) == length; };
+    bool ok = true;
+    for (size_t line = 0, q = 0; line < localAnswer.size() && ok; line++) {
+        if (!localAnswer[line].empty()) {
+            cout << localAnswer[line] << "\n";
+            continue;
+        }
+        uint32_t bodyLength;
+        uint8_t status;
+        ok = readExactly(&bodyLength, 4) && readExactly(&status, 1);
+        if (!ok) break;
+        string body(bodyLength - 1, '\0');
+        ok = readExactly(&body[0], body.size());
+        if (!ok) break;
+        uint8_t requestOp = frames[q++][4];
+        if (status != STATUS_OK) {
+            cout << "bad request\n";
+        } else if (requestOp == OP_LOCATE) {
+            uint32_t returned = getValue<uint32_t>(body.data() + 8);
+            for (uint32_t k = 0; k < returned; k++) cout << getValue<int32_t>(body.data() + 12 + 4 * k) << " ";
+            cout << "\n";
+        } else {
+            cout << getValue<uint64_t>(body.data()) << "\n";
+        }
+    }
+    writer.join();
+    fclose(responses);
+    close(fd);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        cerr << "connection closed by server" << endl;
+        return 1;
+    }
+    cerr << frames.size() << " queries in " << seconds * 1000 << " ms, "
+         << (long long)(frames.size() / max(seconds, 1e-9)) << " queries/s" << endl;
+    return 0;
+}
+
+int32_t main(int argc, char *argv[]) {
+    ios_base::sync_with_stdio(0); cin.tie(0); cout.tie(0);
+    signal(SIGPIPE, SIG_IGN);
+
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "serve" && (argc == 4 || argc == 5)) {
+        int workers = argc == 5 ? atoi(argv[4]) : (int)thread::hardware_concurrency();
+        return serveMode(argv[2], argv[3], max(1, workers));
+    }
+    if (mode == "client" && argc == 3) return clientMode(argv[2]);
+    cerr << "usage: " << argv[0] << " serve <index-file> <socket> [workers]" << endl
+         << "       " << argv[0] << " client <socket>" << endl;
+    return 1;
+}
\ No newline at end of file
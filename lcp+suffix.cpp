@@ -1,12 +1,20 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
-// Function to build the suffix array
-vector<int> buildSuffixArray(const string &s)
+// Build with -DSA_DOUBLING to use the prefix-doubling builder instead of SA-IS,
+// e.g. to cross-check the two on the same input.
+
+// Function to build the suffix array by prefix doubling, O(n log^2 n)
+vector<int> buildSuffixArrayDoubling(string_view s)
 {
     int n = s.size();
     vector<int> suffixArray(n), rank(n), temp(n);
@@ -14,7 +22,7 @@ vector<int> buildSuffixArray(const string &s)
     for (int i = 0; i < n; ++i)
     {
         suffixArray[i] = i;
-        rank[i] = s[i];
+        rank[i] = (unsigned char)s[i];
     }
 
     for (int k = 1; k < n; k *= 2)
@@ -40,8 +48,152 @@ vector<int> buildSuffixArray(const string &s)
     return suffixArray;
 }
 
+// SA-IS (induced sorting), O(n). `s` holds symbols in [0, upper]; the end of the
+// string acts as a virtual sentinel smaller than every symbol.
+vector<int> inducedSort(const vector<int> &s, int upper)
+{
+    int n = s.size();
+    if (n == 0)
+        return {};
+    if (n == 1)
+        return {0};
+    if (n == 2)
+        return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    // Classify suffixes: S-type if smaller than the suffix to its right, else L-type
+    vector<bool> isS(n, false);
+    for (int i = n - 2; i >= 0; --i)
+    {
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // Bucket boundaries: bucketL[c] = start of c's bucket, bucketS[c] = start of its S-part
+    vector<int> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        if (isS[i])
+            bucketL[s[i] + 1]++;
+        else
+            bucketS[s[i]]++;
+    }
+    for (int c = 0; c <= upper; ++c)
+    {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    vector<int> suffixArray(n), bucket(upper + 2);
+    auto induce = [&](const vector<int> &lms)
+    {
+        fill(suffixArray.begin(), suffixArray.end(), -1);
+
+        // Place LMS suffixes at the S-part of their buckets
+        copy(bucketS.begin(), bucketS.end(), bucket.begin());
+        for (int p : lms)
+        {
+            suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce L-type suffixes left to right
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        suffixArray[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i)
+        {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && !isS[p])
+                suffixArray[bucket[s[p]]++] = p;
+        }
+
+        // Induce S-type suffixes right to left
+        copy(bucketL.begin(), bucketL.end(), bucket.begin());
+        for (int i = n - 1; i >= 0; --i)
+        {
+            int p = suffixArray[i] - 1;
+            if (p >= 0 && isS[p])
+                suffixArray[--bucket[s[p] + 1]] = p;
+        }
+    };
+
+    vector<int> lmsIndex(n, -1), lms;
+    for (int i = 1; i < n; ++i)
+    {
+        if (!isS[i - 1] && isS[i])
+        {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+
+    induce(lms);
+    if (m == 0)
+        return suffixArray;
+
+    // Name the LMS substrings in sorted order, then sort the reduced string recursively
+    vector<int> sortedLms;
+    sortedLms.reserve(m);
+    for (int p : suffixArray)
+    {
+        if (p >= 0 && lmsIndex[p] != -1)
+            sortedLms.push_back(p);
+    }
+
+    vector<int> reduced(m);
+    int names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int i = 1; i < m; ++i)
+    {
+        int a = sortedLms[i - 1], b = sortedLms[i];
+        int endA = (lmsIndex[a] + 1 < m) ? lms[lmsIndex[a] + 1] : n;
+        int endB = (lmsIndex[b] + 1 < m) ? lms[lmsIndex[b] + 1] : n;
+        bool same = (endA - a == endB - b);
+        if (same)
+        {
+            while (a < endA && s[a] == s[b])
+            {
+                ++a;
+                ++b;
+            }
+            same = (a < n && b < n && s[a] == s[b]);
+        }
+        if (!same)
+            ++names;
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    vector<int> reducedSA = inducedSort(reduced, names);
+    for (int i = 0; i < m; ++i)
+    {
+        sortedLms[i] = lms[reducedSA[i]];
+    }
+    induce(sortedLms);
+
+    return suffixArray;
+}
+
+// Function to build the suffix array with SA-IS, O(n)
+vector<int> buildSuffixArraySAIS(string_view s)
+{
+    vector<int> symbols(s.begin(), s.end());
+    for (int &c : symbols)
+    {
+        c &= 0xFF;
+    }
+    return inducedSort(symbols, 255);
+}
+
+// Function to build the suffix array
+vector<int> buildSuffixArray(string_view s)
+{
+#ifdef SA_DOUBLING
+    return buildSuffixArrayDoubling(s);
+#else
+    return buildSuffixArraySAIS(s);
+#endif
+}
+
 // Function to build the LCP array using Kasai's algorithm
-vector<int> buildLCPArray(const string &s, const vector<int> &suffixArray)
+vector<int> buildLCPArray(string_view s, const vector<int> &suffixArray)
 {
     int n = s.size();
     vector<int> rank(n), lcp(n);
@@ -70,10 +222,80 @@ vector<int> buildLCPArray(const string &s, const vector<int> &suffixArray)
     return lcp;
 }
 
-int main()
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText
+{
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path)
+    {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0)
+        {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0)
+                    ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0)
+        {
+            if (k < 0 && errno == EINTR)
+                continue;
+            if (k < 0)
+                break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0)
+            ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText()
+    {
+        if (mapped != MAP_FAILED)
+            munmap(mapped, size);
+    }
+};
+
+// ./lcp+suffix [file | -]: the whole file (or stdin) is the text, every byte included.
+// Without an argument the text is the first whitespace-separated word of stdin.
+int main(int argc, char *argv[])
 {
-    string s;
-    cin >> s;
+    InputText input;
+    string word;
+    string_view s;
+    if (argc > 1)
+    {
+        if (!input.open(argv[1]))
+        {
+            cerr << "cannot read " << argv[1] << endl;
+            return 1;
+        }
+        s = input.view();
+    }
+    else
+    {
+        cin >> word;
+        s = word;
+    }
     int n = s.size();
 
     vector<int> suffixArray = buildSuffixArray(s);
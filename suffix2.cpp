@@ -2,24 +2,33 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
-// Function to build suffix array
-vector<int> buildSuffixArray(const string &s) {
-    int n = s.size();
-    vector<int> suffixArray(n), classes(n), c(n), cnt(max(256, n), 0);
+// Function to build suffix array of s plus an explicit sentinel at position s.size()
+vector<int> buildSuffixArray(string_view s) {
+    int n = s.size() + 1;
+    vector<int> suffixArray(n), classes(n), c(n), cnt(max(257, n), 0);
+
+    // Sort key of the first character: 0 for the sentinel, byte + 1 otherwise
+    // (as unsigned: bytes >= 128 are not negative indices)
+    auto key = [&](int i) { return i == n - 1 ? 0 : (unsigned char)s[i] + 1; };
 
     // Initial sorting by the first character
-    for (int i = 0; i < n; i++) cnt[s[i]]++;
-    for (int i = 1; i < 256; i++) cnt[i] += cnt[i - 1];
-    for (int i = 0; i < n; i++) suffixArray[--cnt[s[i]]] = i;
+    for (int i = 0; i < n; i++) cnt[key(i)]++;
+    for (int i = 1; i < 257; i++) cnt[i] += cnt[i - 1];
+    for (int i = 0; i < n; i++) suffixArray[--cnt[key(i)]] = i;
 
     // Initial classes
     classes[suffixArray[0]] = 0;
     int numClasses = 1;
     for (int i = 1; i < n; i++) {
-        if (s[suffixArray[i]] != s[suffixArray[i - 1]]) numClasses++;
+        if (key(suffixArray[i]) != key(suffixArray[i - 1])) numClasses++;
         classes[suffixArray[i]] = numClasses - 1;
     }
 
@@ -50,11 +59,65 @@ vector<int> buildSuffixArray(const string &s) {
     return suffixArray;
 }
 
-int main() {
-    string s;
-    cin >> s;
-    s += "$"; // Append a unique character that is lexicographically smaller than any other character in the string
+// Binary-safe text input (documented in Suffix_Array_and_LCP_Array.cpp)
+struct InputText {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapped = MAP_FAILED;
+    string buffer;
+
+    // path "-" is stdin; returns false if the input cannot be read
+    bool open(const string &path) {
+        int fd = path == "-" ? 0 : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = (const char *)mapped;
+                size = st.st_size;
+                if (fd != 0) ::close(fd);
+                return true;
+            }
+        }
+        vector<char> block(1 << 20);
+        ssize_t k;
+        while ((k = read(fd, block.data(), block.size())) != 0) {
+            if (k < 0 && errno == EINTR) continue;
+            if (k < 0) break;
+            buffer.append(block.data(), k);
+        }
+        if (fd != 0) ::close(fd);
+        data = buffer.data();
+        size = buffer.size();
+        return k == 0;
+    }
+
+    string_view view() const { return string_view(data, size); }
+
+    ~InputText() {
+        if (mapped != MAP_FAILED) munmap(mapped, size);
+    }
+};
+
+// ./suffix2 [file | -]: the whole file (or stdin) is the text, every byte included.
+// Without an argument the text is the first whitespace-separated word of stdin.
+int main(int argc, char *argv[]) {
+    InputText input;
+    string word;
+    string_view s;
+    if (argc > 1) {
+        if (!input.open(argv[1])) {
+            cerr << "cannot read " << argv[1] << endl;
+            return 1;
+        }
+        s = input.view();
+    } else {
+        cin >> word;
+        s = word;
+    }
 
+    // The sentinel is position s.size(), ranked below every byte; nothing is appended to the text
     vector<int> suffixArray = buildSuffixArray(s);
 
     for (int i = 0; i < suffixArray.size(); i++) { // Skip the first entry which is the added '$'